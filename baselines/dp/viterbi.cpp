@@ -3,6 +3,7 @@
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <cmath>
 #include <algorithm>
 #include "../utils.hpp"
 
@@ -54,8 +55,54 @@ double run_viterbi(const std::vector<Observation>& obs) {
     return final_max_p;
 }
 
+// Full-table reference for path recovery: keeps all T x S backpointers. V is
+// divided by its maximum each step so long inputs do not underflow.
+double run_viterbi_path(const std::vector<Observation>& obs, std::vector<int>& path) {
+    double start_p[] = {0.6, 0.4};
+    double trans_p[2][2] = {{0.7, 0.3}, {0.4, 0.6}};
+    double emit_p[2][4] = {{0.1, 0.4, 0.4, 0.1}, {0.6, 0.2, 0.1, 0.1}};
+    size_t T = obs.size();
+    size_t S = 2;
+    path.assign(T, 0);
+    if (T == 0) return 0.0;
+
+    std::vector<int> backpointers(T * S, 0);
+    std::vector<double> V(S);
+    double top = 0.0;
+    for (size_t s = 0; s < S; ++s) {
+        V[s] = start_p[s] * emit_p[s][obs[0]];
+        top = std::max(top, V[s]);
+    }
+    for (size_t s = 0; s < S; ++s) V[s] /= top;
+    double log_p = std::log(top);
+
+    for (size_t t = 1; t < T; ++t) {
+        std::vector<double> next_V(S);
+        top = 0.0;
+        for (size_t s = 0; s < S; ++s) {
+            double max_p = -1.0;
+            for (size_t i = 0; i < S; ++i) {
+                double p = V[i] * trans_p[i][s];
+                if (p > max_p) {
+                    max_p = p;
+                    backpointers[t * S + s] = static_cast<int>(i);
+                }
+            }
+            next_V[s] = max_p * emit_p[s][obs[t]];
+            top = std::max(top, next_V[s]);
+        }
+        for (size_t s = 0; s < S; ++s) next_V[s] /= top;
+        log_p += std::log(top);
+        V = next_V;
+    }
+
+    path[T - 1] = static_cast<int>(std::max_element(V.begin(), V.end()) - V.begin());
+    for (size_t t = T - 1; t > 0; --t) path[t - 1] = backpointers[t * S + path[t]];
+    return log_p;
+}
+
 int main(int argc, char* argv[]) {
-    // Usage: ./viterbi [Path]
+    // Usage: ./viterbi [Path] [path_out]
     if (argc < 2) return 1;
     std::vector<Observation> obs = load_observations(argv[1]);
 
@@ -63,6 +110,13 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Algorithm: Viterbi" << std::endl;
     std::cout << "Result_Check: " << result << std::endl;
+    if (argc > 2) {
+        std::vector<int> path;
+        double log_p = run_viterbi_path(obs, path);
+        std::ofstream out(argv[2]);
+        for (int s : path) out << s << "\n";
+        std::cout << "Path_Log_Probability: " << log_p << std::endl;
+    }
     std::cout << "Time_us: 0" << std::endl;
     std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
 
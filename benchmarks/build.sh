@@ -6,11 +6,37 @@ echo "[SRF] Building C++ Baselines and SRF Variants..."
 # Output directory for binaries
 mkdir -p build
 
+# Per-ISA SIMD kernels are only built with their instruction-set flags on x86;
+# elsewhere they compile to stubs and the portable kernel is used.
+SSE41_FLAGS=""
+AVX2_FLAGS=""
+AVX512_FLAGS=""
+case "$(uname -m)" in
+    x86_64|amd64|i?86)
+        SSE41_FLAGS="-msse4.1"
+        AVX2_FLAGS="-mavx2"
+        AVX512_FLAGS="-mavx512f -mavx512bw"
+        ;;
+esac
+
 # Common objects
 g++ -std=c++17 -O3 -c srf/runtime/backend_selector.cpp -o build/backend_selector.o
+g++ -std=c++17 -O3 -c srf/backends/cpu/nw_simd.cpp -o build/nw_simd.o
+g++ -std=c++17 -O3 $SSE41_FLAGS -c srf/backends/cpu/nw_simd_sse41.cpp -o build/nw_simd_sse41.o
+g++ -std=c++17 -O3 $AVX2_FLAGS -c srf/backends/cpu/nw_simd_avx2.cpp -o build/nw_simd_avx2.o
+g++ -std=c++17 -O3 $AVX512_FLAGS -c srf/backends/cpu/nw_simd_avx512.cpp -o build/nw_simd_avx512.o
+SIMD_OBJS="build/nw_simd.o build/nw_simd_sse41.o build/nw_simd_avx2.o build/nw_simd_avx512.o"
+# HMM kernels keep multiply and add separate so every ISA matches the scalar recurrence bit for bit.
+g++ -std=c++17 -O3 -ffp-contract=off -c srf/backends/cpu/hmm_simd.cpp -o build/hmm_simd.o
+g++ -std=c++17 -O3 -ffp-contract=off $AVX2_FLAGS -c srf/backends/cpu/hmm_simd_avx2.cpp -o build/hmm_simd_avx2.o
+g++ -std=c++17 -O3 -ffp-contract=off $AVX512_FLAGS -c srf/backends/cpu/hmm_simd_avx512.cpp -o build/hmm_simd_avx512.o
+HMM_OBJS="build/hmm_simd.o build/hmm_simd_avx2.o build/hmm_simd_avx512.o"
 g++ -std=c++17 -O3 -c srf/control/regime_observer.cpp -o build/regime_observer.o
 g++ -std=c++17 -O3 -c srf/control/drift_detector.cpp -o build/drift_detector.o
 g++ -std=c++17 -O3 -c srf/control/adaptation_policy.cpp -o build/adaptation_policy.o
+g++ -std=c++17 -O3 -pthread -c srf/runtime/thread_pool.cpp -o build/thread_pool.o
+g++ -std=c++17 -O3 -pthread -c srf/runtime/work_stealing_pool.cpp -o build/work_stealing_pool.o
+g++ -std=c++17 -O3 -pthread -c srf/runtime/stream_prefetcher.cpp -o build/stream_prefetcher.o
 
 # Compile baselines
 g++ -std=c++17 -O3 baselines/dp/needleman_wunsch.cpp -o build/needleman_wunsch
@@ -19,9 +45,12 @@ g++ -std=c++17 -O3 baselines/dp/forward.cpp -o build/forward
 g++ -std=c++17 -O3 baselines/graph/graph_dp.cpp -o build/graph_dp
 
 # Compile SRF Variants with Backend and Control Support
-g++ -std=c++17 -O3 srf/dp/nw_blocked.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o -o build/nw_blocked
-g++ -std=c++17 -O3 srf/dp/viterbi_checkpoint.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o -o build/viterbi_checkpoint
-g++ -std=c++17 -O3 srf/dp/forward_checkpoint.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o -o build/forward_checkpoint
-g++ -std=c++17 -O3 srf/graph/graph_recompute.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o -o build/graph_recompute
+g++ -std=c++17 -O3 -pthread srf/dp/nw_blocked.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o build/thread_pool.o build/stream_prefetcher.o $SIMD_OBJS $HMM_OBJS -o build/nw_blocked
+g++ -std=c++17 -O3 -pthread srf/dp/nw_batch.cpp build/backend_selector.o build/regime_observer.o build/thread_pool.o build/work_stealing_pool.o $SIMD_OBJS $HMM_OBJS -o build/nw_batch
+g++ -std=c++17 -O3 -pthread srf/dp/viterbi_checkpoint.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o build/thread_pool.o build/stream_prefetcher.o $SIMD_OBJS $HMM_OBJS -o build/viterbi_checkpoint
+g++ -std=c++17 -O3 -pthread srf/dp/forward_checkpoint.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o build/thread_pool.o $SIMD_OBJS $HMM_OBJS -o build/forward_checkpoint
+g++ -std=c++17 -O3 -pthread srf/dp/hmm_batch.cpp build/backend_selector.o build/regime_observer.o build/thread_pool.o $SIMD_OBJS $HMM_OBJS -o build/hmm_batch
+g++ -std=c++17 -O3 -pthread srf/dp/hmm_train.cpp build/regime_observer.o build/thread_pool.o $SIMD_OBJS $HMM_OBJS -o build/hmm_train
+g++ -std=c++17 -O3 -pthread srf/graph/graph_recompute.cpp build/backend_selector.o build/regime_observer.o build/drift_detector.o build/adaptation_policy.o build/thread_pool.o $SIMD_OBJS $HMM_OBJS -o build/graph_recompute
 
 echo "[SRF] Build completed."
@@ -0,0 +1,69 @@
+import os
+import random
+
+WEATHER_START = [0.6, 0.4]
+WEATHER_TRANS = [[0.7, 0.3], [0.4, 0.6]]
+WEATHER_EMIT = [[0.1, 0.4, 0.4, 0.1], [0.6, 0.2, 0.1, 0.1]]
+
+def write_model(path, alphabet, start, trans, emit, comment):
+    with open(path, 'w') as f:
+        f.write(f"# {comment}\n")
+        f.write(f"states {len(start)}\n")
+        f.write(f"alphabet {alphabet}\n")
+        f.write("start " + " ".join(f"{p:.10g}" for p in start) + "\n")
+        f.write("transitions\n")
+        for row in trans:
+            f.write(" ".join(f"{p:.10g}" for p in row) + "\n")
+        f.write("emissions\n")
+        for row in emit:
+            f.write(" ".join(f"{p:.10g}" for p in row) + "\n")
+
+def split_weather(copies, path):
+    # Each weather state becomes `copies` interchangeable states, so the model
+    # assigns every sequence the same likelihood as the two-state original.
+    states = [s for s in range(2) for _ in range(copies)]
+    start = [WEATHER_START[s] / copies for s in states]
+    trans = [[WEATHER_TRANS[i][j] / copies for j in states] for i in states]
+    emit = [WEATHER_EMIT[s] for s in states]
+    write_model(path, "ACG*", start, trans, emit,
+                f"Weather model with each state split into {copies} copies (same likelihoods)")
+
+def random_row(width):
+    row = [random.random() + 1e-3 for _ in range(width)]
+    total = sum(row)
+    return [p / total for p in row]
+
+def random_model(states, seed, path):
+    random.seed(seed)
+    start = random_row(states)
+    trans = [random_row(states) for _ in range(states)]
+    emit = [random_row(4) for _ in range(states)]
+    write_model(path, "ACGT", start, trans, emit, f"Random {states}-state model (seed {seed})")
+
+def read_set(source, count, seed, path):
+    # Substrings of 50 to 300 symbols at random offsets, one per line, for hmm_batch.
+    random.seed(seed)
+    with open(source) as f:
+        seq = f.read().strip()
+    with open(path, 'w') as f:
+        for _ in range(count):
+            length = random.randint(50, 300)
+            offset = random.randint(0, len(seq) - length)
+            f.write(seq[offset:offset + length] + "\n")
+
+def main():
+    os.makedirs("datasets/models", exist_ok=True)
+    write_model("datasets/models/weather.hmm", "ACG*", WEATHER_START, WEATHER_TRANS, WEATHER_EMIT,
+                "The two-state weather model hard-coded in baselines/dp/forward.cpp and viterbi.cpp")
+    split_weather(20, "datasets/models/weather_split_40.hmm")
+
+    model_dir = "datasets_extreme/models"
+    os.makedirs(model_dir, exist_ok=True)
+    for states in [2, 8, 32, 128, 256, 512]:
+        random_model(states, states, os.path.join(model_dir, f"random_s{states}.hmm"))
+    read_set("datasets_extreme/sequences/seq_a_1000000.txt", 20000, 3, os.path.join(model_dir, "reads_20000.txt"))
+
+    print("HMM models generated.")
+
+if __name__ == "__main__":
+    main()
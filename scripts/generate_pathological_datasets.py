@@ -7,8 +7,10 @@ def generate_seq(length, seed, path):
     with open(path, 'w') as f:
         f.write("".join(random.choice(bases) for _ in range(length)))
 
-def generate_graph(nodes, mode, path):
-    # Mode: 'path' (linear) or 'dense' (high fan-in)
+def generate_graph(nodes, mode, path, width=1):
+    # Mode: 'path' (linear), 'dense' (high fan-in) or 'layered' (shallow and wide:
+    # nodes / width layers, each node feeding 3 random nodes of the next layer)
+    random.seed(nodes)
     with open(path, 'w') as f:
         if mode == 'path':
             for u in range(nodes - 1):
@@ -17,6 +19,11 @@ def generate_graph(nodes, mode, path):
             for u in range(nodes):
                 for v in range(u + 1, min(u + 21, nodes)):
                     f.write(f"{u} {v} 1\n")
+        elif mode == 'layered':
+            for u in range(nodes - width):
+                layer_start = (u // width + 1) * width
+                for v in sorted(random.sample(range(layer_start, min(layer_start + width, nodes)), 3)):
+                    f.write(f"{u} {v} 1\n")
 
 def main():
     path_dir = "datasets_extreme/pathological"
@@ -34,6 +41,7 @@ def main():
     # 3. Graph Topology Extremes
     generate_graph(1000, 'path', os.path.join(path_dir, "graph_path.txt"))
     generate_graph(1000, 'dense', os.path.join(path_dir, "graph_dense.txt"))
+    generate_graph(65536, 'layered', os.path.join(path_dir, "graph_layered.txt"), width=4096)
 
     print("Pathological datasets generated.")
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <algorithm>
 
 namespace srf {
 
@@ -16,6 +17,8 @@ struct BackendMetrics {
     long long transfer_overhead_us = 0;
     long long kernel_launch_count = 0;
     size_t device_memory_budget_kb = 0;
+    std::string kernel = "cell";      // "cell" (per-cell primitives) or e.g. "simd-avx2-i16"
+    long long fused_cell_count = 0;   // Cells evaluated inside whole-matrix kernels
 };
 
 class IBackend {
@@ -31,10 +34,62 @@ public:
 
     // Primitives
     virtual int nw_cell_compute(int diag, int top, int left, int match_score, int gap_penalty) = 0;
+
+    // Batched NW scores: scores[k] = score(s1[k], s2[k]). The default walks every
+    // pair through nw_cell_compute; vectorized backends align several pairs per instruction.
+    virtual void nw_batch_compute(const std::vector<std::string>& s1, const std::vector<std::string>& s2,
+                                  int match, int mismatch, int gap, std::vector<int>& scores) {
+        scores.assign(std::min(s1.size(), s2.size()), 0);
+        std::vector<int> prev, curr;
+        for (size_t k = 0; k < scores.size(); ++k) {
+            const std::string& a = s1[k];
+            const std::string& b = s2[k];
+            prev.resize(b.length() + 1);
+            curr.resize(b.length() + 1);
+            for (size_t j = 0; j <= b.length(); ++j) prev[j] = static_cast<int>(j) * gap;
+            for (size_t i = 1; i <= a.length(); ++i) {
+                curr[0] = static_cast<int>(i) * gap;
+                for (size_t j = 1; j <= b.length(); ++j) {
+                    int match_score = (a[i - 1] == b[j - 1]) ? match : mismatch;
+                    curr[j] = nw_cell_compute(prev[j - 1], prev[j], curr[j - 1], match_score, gap);
+                }
+                std::swap(prev, curr);
+            }
+            scores[k] = prev[b.length()];
+        }
+    }
     virtual double forward_step_compute(const std::vector<double>& prev_alpha, const std::vector<double>& trans_row, double emission) = 0;
+
+    // Batched forward step over several sequences side by side. Vectors are
+    // state-major with one column per sequence (prev[i * lanes + l]):
+    //   out[j * lanes + l] = sum_i prev[i * lanes + l] * trans[i * states + j] * emission[j * lanes + l]
+    // The default runs forward_step_compute per sequence and state; vectorized
+    // backends give each sequence a SIMD lane.
+    virtual void forward_batch_step(const std::vector<double>& prev, const std::vector<double>& trans,
+                                    const std::vector<double>& emission, size_t states, std::vector<double>& out) {
+        const size_t lanes = states > 0 ? prev.size() / states : 0;
+        out.resize(prev.size());
+        std::vector<double> alpha(states), column(states);
+        for (size_t l = 0; l < lanes; ++l) {
+            for (size_t i = 0; i < states; ++i) alpha[i] = prev[i * lanes + l];
+            for (size_t j = 0; j < states; ++j) {
+                for (size_t i = 0; i < states; ++i) column[i] = trans[i * states + j];
+                out[j * lanes + l] = forward_step_compute(alpha, column, emission[j * lanes + l]);
+            }
+        }
+    }
     virtual double viterbi_step_compute(const std::vector<double>& prev_v, const std::vector<double>& trans_row, double emission) = 0;
     virtual int graph_node_compute(const std::vector<int>& predecessor_dists, const std::vector<int>& weights) = 0;
 
+    // Whole-matrix NW score kernel. Backends without one return false and callers
+    // fall back to nw_cell_compute. has_nw_score_kernel() reports support up front,
+    // so callers only prepare the kernel's input when it will be used.
+    virtual bool nw_score_kernel(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+        (void)s1; (void)s2; (void)match; (void)mismatch; (void)gap; (void)score;
+        return false;
+    }
+    virtual bool has_nw_score_kernel() const { return false; }
+
     virtual BackendMetrics get_metrics() const = 0;
     virtual void reset_metrics() = 0;
 };
@@ -2,14 +2,31 @@
 #define SRF_BACKENDS_CPU_BACKEND_H
 
 #include "../backend_interface.h"
+#include "nw_simd.h"
+#include "hmm_simd.h"
 #include <algorithm>
 #include <cstring>
 
 namespace srf {
 
+enum class CpuKernelMode {
+    CELL,   // Per-cell primitives only
+    SIMD    // Vectorized whole-matrix kernels where available
+};
+
 class CpuBackend : public IBackend {
+private:
+    CpuKernelMode mode_;
+    SimdIsa isa_;
+    HmmKernels hmm_;
+    std::string hmm_kernel_name_;
+    BackendMetrics metrics_;
 public:
+    explicit CpuBackend(CpuKernelMode mode = CpuKernelMode::CELL, SimdIsa isa = SimdIsa::AVX512)
+        : mode_(mode), isa_(isa), hmm_(hmm_kernels(isa)), hmm_kernel_name_("batch-" + simd_isa_name(hmm_.isa) + "-f64") {}
+
     BackendType type() const override { return BackendType::CPU; }
+    CpuKernelMode mode() const { return mode_; }
 
     void* allocate_device(size_t size) override { return malloc(size); }
     void free_device(void* ptr) override { free(ptr); }
@@ -44,8 +61,48 @@ public:
         return min_dist;
     }
 
-    BackendMetrics get_metrics() const override { return {0, 0, 0}; }
-    void reset_metrics() override {}
+    bool nw_score_kernel(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) override {
+        if (mode_ != CpuKernelMode::SIMD) return false;
+        NwSimdReport report;
+        score = nw_simd_score(s1, s2, match, mismatch, gap, isa_, report);
+        metrics_.kernel = "simd-" + simd_isa_name(report.isa) + "-i" + std::to_string(report.lane_bits) +
+                          (report.overflow_fallback ? "-fallback" : "");
+        metrics_.fused_cell_count += static_cast<long long>(s1.length()) * static_cast<long long>(s2.length());
+        return true;
+    }
+
+    bool has_nw_score_kernel() const override { return mode_ == CpuKernelMode::SIMD; }
+
+    void nw_batch_compute(const std::vector<std::string>& s1, const std::vector<std::string>& s2,
+                          int match, int mismatch, int gap, std::vector<int>& scores) override {
+        if (mode_ != CpuKernelMode::SIMD) {
+            IBackend::nw_batch_compute(s1, s2, match, mismatch, gap, scores);
+            return;
+        }
+        NwSimdReport report;
+        nw_intertask_score(s1, s2, match, mismatch, gap, isa_, scores, report);
+        metrics_.kernel = "intertask-" + simd_isa_name(report.isa) + "-i" + std::to_string(report.lane_bits) +
+                          (report.overflow_fallback ? "-fallback" : "");
+        for (size_t k = 0; k < scores.size(); ++k) {
+            metrics_.fused_cell_count += static_cast<long long>(s1[k].length()) * static_cast<long long>(s2[k].length());
+        }
+    }
+
+    void forward_batch_step(const std::vector<double>& prev, const std::vector<double>& trans,
+                            const std::vector<double>& emission, size_t states, std::vector<double>& out) override {
+        if (mode_ != CpuKernelMode::SIMD) {
+            IBackend::forward_batch_step(prev, trans, emission, states, out);
+            return;
+        }
+        const size_t lanes = states > 0 ? prev.size() / states : 0;
+        out.resize(prev.size());
+        hmm_.batch_forward(trans.data(), states, states, prev.data(), emission.data(), lanes, out.data());
+        metrics_.kernel = hmm_kernel_name_;
+        metrics_.fused_cell_count += static_cast<long long>(states * states * lanes);
+    }
+
+    BackendMetrics get_metrics() const override { return metrics_; }
+    void reset_metrics() override { metrics_ = BackendMetrics(); }
 };
 
 } // namespace srf
@@ -0,0 +1,59 @@
+#include "hmm_simd.h"
+#include "hmm_simd_kernel.h"
+
+namespace srf {
+
+void hmm_mat_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out) {
+    hmm_mat_vec<HmmScalarOps>(M, S, stride, x, out);
+}
+
+void hmm_max_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_vec<HmmScalarOps>(M, S, stride, x, out, arg);
+}
+
+void hmm_max_plus_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_plus_vec<HmmScalarOps>(M, S, stride, x, out, arg);
+}
+
+void hmm_exp_shift_scalar(const double* x, double shift, size_t n, double* out) {
+    hmm_exp_shift<HmmScalarOps>(x, shift, n, out);
+}
+
+void hmm_log_add_scalar(const double* y, const double* add, double base, size_t n, double* out) {
+    hmm_log_add<HmmScalarOps>(y, add, base, n, out);
+}
+
+void hmm_batch_forward_scalar(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out) {
+    hmm_batch_forward<HmmScalarOps>(M, S, stride, x, emit, lanes, out);
+}
+
+HmmKernels hmm_kernels(SimdIsa requested) {
+    HmmKernels k;
+    k.mat_vec = hmm_mat_vec_scalar;
+    k.max_vec = hmm_max_vec_scalar;
+    k.max_plus_vec = hmm_max_plus_vec_scalar;
+    k.exp_shift = hmm_exp_shift_scalar;
+    k.log_add = hmm_log_add_scalar;
+    k.batch_forward = hmm_batch_forward_scalar;
+    SimdIsa isa = resolve_simd_isa(requested);
+    if (isa == SimdIsa::AVX512 && hmm_simd_avx512_compiled) {
+        k.isa = SimdIsa::AVX512;
+        k.mat_vec = hmm_mat_vec_avx512;
+        k.max_vec = hmm_max_vec_avx512;
+        k.max_plus_vec = hmm_max_plus_vec_avx512;
+        k.exp_shift = hmm_exp_shift_avx512;
+        k.log_add = hmm_log_add_avx512;
+        k.batch_forward = hmm_batch_forward_avx512;
+    } else if (isa >= SimdIsa::AVX2 && hmm_simd_avx2_compiled) {
+        k.isa = SimdIsa::AVX2;
+        k.mat_vec = hmm_mat_vec_avx2;
+        k.max_vec = hmm_max_vec_avx2;
+        k.max_plus_vec = hmm_max_plus_vec_avx2;
+        k.exp_shift = hmm_exp_shift_avx2;
+        k.log_add = hmm_log_add_avx2;
+        k.batch_forward = hmm_batch_forward_avx2;
+    }
+    return k;
+}
+
+} // namespace srf
@@ -0,0 +1,59 @@
+#ifndef SRF_BACKENDS_CPU_HMM_SIMD_H
+#define SRF_BACKENDS_CPU_HMM_SIMD_H
+
+#include <cstddef>
+#include "nw_simd.h"
+
+namespace srf {
+
+// Dense HMM step kernels over an S x S matrix M stored row-major with a row
+// stride of `stride` doubles (rows 64-byte aligned, stride a multiple of 8).
+//   mat_vec: out[s] = sum_i x[i] * M[i][s], summed in ascending i
+//   max_vec: out[s] = max_i x[i] * M[i][s], arg[s] = the lowest i attaining it
+//   max_plus_vec: as max_vec with x[i] + M[i][s] (log-space Viterbi)
+// These write out[0 .. S) only; x and out may be unaligned but must not overlap.
+// Vector helpers (identical results on every ISA, within a few ulp of std::exp / std::log):
+//   exp_shift: out[i] = exp(x[i] - shift) for x[i] <= shift (0 below e^-708)
+//   log_add:   out[i] = (base + log(y[i])) + add[i]; out may alias y
+//   batch_forward: one sequence per lane, vectors state-major (x[i * lanes + l]):
+//                  out[s * lanes + l] = (sum_i x[i * lanes + l] * M[i][s]) * emit[s * lanes + l]
+//                  M needs no alignment here; any lane count is accepted.
+struct HmmKernels {
+    SimdIsa isa = SimdIsa::SCALAR;
+    void (*mat_vec)(const double* M, size_t S, size_t stride, const double* x, double* out) = nullptr;
+    void (*max_vec)(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) = nullptr;
+    void (*max_plus_vec)(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) = nullptr;
+    void (*exp_shift)(const double* x, double shift, size_t n, double* out) = nullptr;
+    void (*log_add)(const double* y, const double* add, double base, size_t n, double* out) = nullptr;
+    void (*batch_forward)(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out) = nullptr;
+};
+
+// Kernels for the widest available ISA not above `requested`. There is no
+// SSE4.1 variant; the portable kernel is already SSE2-vectorized.
+HmmKernels hmm_kernels(SimdIsa requested);
+
+void hmm_mat_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out);
+void hmm_max_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_max_plus_vec_scalar(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_exp_shift_scalar(const double* x, double shift, size_t n, double* out);
+void hmm_log_add_scalar(const double* y, const double* add, double base, size_t n, double* out);
+void hmm_batch_forward_scalar(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out);
+void hmm_mat_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out);
+void hmm_max_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_max_plus_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_exp_shift_avx2(const double* x, double shift, size_t n, double* out);
+void hmm_log_add_avx2(const double* y, const double* add, double base, size_t n, double* out);
+void hmm_batch_forward_avx2(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out);
+void hmm_mat_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out);
+void hmm_max_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_max_plus_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg);
+void hmm_exp_shift_avx512(const double* x, double shift, size_t n, double* out);
+void hmm_log_add_avx512(const double* y, const double* add, double base, size_t n, double* out);
+void hmm_batch_forward_avx512(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out);
+
+extern const bool hmm_simd_avx2_compiled;
+extern const bool hmm_simd_avx512_compiled;
+
+} // namespace srf
+
+#endif
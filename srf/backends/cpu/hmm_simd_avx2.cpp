@@ -0,0 +1,94 @@
+#include "hmm_simd.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include "hmm_simd_kernel.h"
+
+namespace srf {
+
+namespace {
+
+struct Avx2OpsF64 {
+    using vec = __m256d;
+    static constexpr size_t lanes = 4;
+
+    static vec zero() { return _mm256_setzero_pd(); }
+    static vec set1(double x) { return _mm256_set1_pd(x); }
+    static vec load(const double* p) { return _mm256_load_pd(p); }
+    static vec loadu(const double* p) { return _mm256_loadu_pd(p); }
+    static void storeu(double* p, vec v) { _mm256_storeu_pd(p, v); }
+    static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+    static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+    static vec round_nearest(vec a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    // 2^n: n + 1023 lands in the low mantissa bits of 2^52 + n + 1023 and is shifted into the exponent.
+    static vec pow2(vec n) {
+        const __m256i biased = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(0x1p52 + 1023.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+    }
+    static void split(vec y, vec& e, vec& m) {
+        const __m256i bits = _mm256_castpd_si256(y);
+        const __m256i exponent = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x4330000000000000LL));
+        e = _mm256_sub_pd(_mm256_castsi256_pd(exponent), _mm256_set1_pd(0x1p52 + 1023.0));
+        m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL)),
+                                                _mm256_set1_epi64x(0x3ff0000000000000LL)));
+    }
+    static vec select_less(vec x, vec limit, vec if_less, vec otherwise) {
+        return _mm256_blendv_pd(otherwise, if_less, _mm256_cmp_pd(x, limit, _CMP_LT_OQ));
+    }
+    static void keep_greater(vec cand, vec cand_arg, vec& best, vec& best_arg) {
+        const vec gt = _mm256_cmp_pd(cand, best, _CMP_GT_OQ);
+        best = _mm256_blendv_pd(best, cand, gt);
+        best_arg = _mm256_blendv_pd(best_arg, cand_arg, gt);
+    }
+    static void store_index(int* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtpd_epi32(v)); }
+};
+
+} // namespace
+
+const bool hmm_simd_avx2_compiled = true;
+
+void hmm_mat_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out) {
+    hmm_mat_vec<Avx2OpsF64>(M, S, stride, x, out);
+}
+
+void hmm_max_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_vec<Avx2OpsF64>(M, S, stride, x, out, arg);
+}
+
+void hmm_max_plus_vec_avx2(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_plus_vec<Avx2OpsF64>(M, S, stride, x, out, arg);
+}
+
+void hmm_exp_shift_avx2(const double* x, double shift, size_t n, double* out) {
+    hmm_exp_shift<Avx2OpsF64>(x, shift, n, out);
+}
+
+void hmm_log_add_avx2(const double* y, const double* add, double base, size_t n, double* out) {
+    hmm_log_add<Avx2OpsF64>(y, add, base, n, out);
+}
+
+void hmm_batch_forward_avx2(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out) {
+    hmm_batch_forward<Avx2OpsF64>(M, S, stride, x, emit, lanes, out);
+}
+
+} // namespace srf
+
+#else
+
+namespace srf {
+
+const bool hmm_simd_avx2_compiled = false;
+
+void hmm_mat_vec_avx2(const double*, size_t, size_t, const double*, double*) {}
+void hmm_max_vec_avx2(const double*, size_t, size_t, const double*, double*, int*) {}
+void hmm_max_plus_vec_avx2(const double*, size_t, size_t, const double*, double*, int*) {}
+void hmm_exp_shift_avx2(const double*, double, size_t, double*) {}
+void hmm_log_add_avx2(const double*, const double*, double, size_t, double*) {}
+void hmm_batch_forward_avx2(const double*, size_t, size_t, const double*, const double*, size_t, double*) {}
+
+} // namespace srf
+
+#endif
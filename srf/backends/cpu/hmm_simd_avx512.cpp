@@ -0,0 +1,87 @@
+#include "hmm_simd.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#include "hmm_simd_kernel.h"
+
+namespace srf {
+
+namespace {
+
+struct Avx512OpsF64 {
+    using vec = __m512d;
+    static constexpr size_t lanes = 8;
+
+    static vec zero() { return _mm512_setzero_pd(); }
+    static vec set1(double x) { return _mm512_set1_pd(x); }
+    static vec load(const double* p) { return _mm512_load_pd(p); }
+    static vec loadu(const double* p) { return _mm512_loadu_pd(p); }
+    static void storeu(double* p, vec v) { _mm512_storeu_pd(p, v); }
+    static vec add(vec a, vec b) { return _mm512_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm512_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm512_mul_pd(a, b); }
+    static vec div(vec a, vec b) { return _mm512_div_pd(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_pd(a, b); }
+    static vec round_nearest(vec a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static vec pow2(vec n) { return _mm512_scalef_pd(_mm512_set1_pd(1.0), n); }
+    static void split(vec y, vec& e, vec& m) {
+        e = _mm512_getexp_pd(y);
+        m = _mm512_getmant_pd(y, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+    }
+    static vec select_less(vec x, vec limit, vec if_less, vec otherwise) {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, limit, _CMP_LT_OQ), otherwise, if_less);
+    }
+    static void keep_greater(vec cand, vec cand_arg, vec& best, vec& best_arg) {
+        const __mmask8 gt = _mm512_cmp_pd_mask(cand, best, _CMP_GT_OQ);
+        best = _mm512_mask_blend_pd(gt, best, cand);
+        best_arg = _mm512_mask_blend_pd(gt, best_arg, cand_arg);
+    }
+    static void store_index(int* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtpd_epi32(v)); }
+};
+
+} // namespace
+
+const bool hmm_simd_avx512_compiled = true;
+
+void hmm_mat_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out) {
+    hmm_mat_vec<Avx512OpsF64>(M, S, stride, x, out);
+}
+
+void hmm_max_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_vec<Avx512OpsF64>(M, S, stride, x, out, arg);
+}
+
+void hmm_max_plus_vec_avx512(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_plus_vec<Avx512OpsF64>(M, S, stride, x, out, arg);
+}
+
+void hmm_exp_shift_avx512(const double* x, double shift, size_t n, double* out) {
+    hmm_exp_shift<Avx512OpsF64>(x, shift, n, out);
+}
+
+void hmm_log_add_avx512(const double* y, const double* add, double base, size_t n, double* out) {
+    hmm_log_add<Avx512OpsF64>(y, add, base, n, out);
+}
+
+void hmm_batch_forward_avx512(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out) {
+    hmm_batch_forward<Avx512OpsF64>(M, S, stride, x, emit, lanes, out);
+}
+
+} // namespace srf
+
+#else
+
+namespace srf {
+
+const bool hmm_simd_avx512_compiled = false;
+
+void hmm_mat_vec_avx512(const double*, size_t, size_t, const double*, double*) {}
+void hmm_max_vec_avx512(const double*, size_t, size_t, const double*, double*, int*) {}
+void hmm_max_plus_vec_avx512(const double*, size_t, size_t, const double*, double*, int*) {}
+void hmm_exp_shift_avx512(const double*, double, size_t, double*) {}
+void hmm_log_add_avx512(const double*, const double*, double, size_t, double*) {}
+void hmm_batch_forward_avx512(const double*, size_t, size_t, const double*, const double*, size_t, double*) {}
+
+} // namespace srf
+
+#endif
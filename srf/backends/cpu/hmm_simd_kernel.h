@@ -0,0 +1,244 @@
+#ifndef SRF_BACKENDS_CPU_HMM_SIMD_KERNEL_H
+#define SRF_BACKENDS_CPU_HMM_SIMD_KERNEL_H
+
+#include <cstddef>
+#include <cmath>
+#include <cfloat>
+#include "hmm_simd.h"
+
+namespace srf {
+
+// Column-blocked dense HMM kernels over an ISA-specific Ops policy.
+//
+// Each block of Blocks * Ops::lanes output columns is accumulated in registers
+// while the rows of M stream past, so out is written once per step instead of
+// once per row. Every column still sums (or compares) its terms in ascending
+// row order with separate multiply and add, so results are bit-identical to
+// the scalar recurrence whatever the ISA (build these with -ffp-contract=off).
+// Ops must provide: vec, lanes, zero, set1, load (aligned), loadu, storeu, add, sub,
+// mul, div, max, round_nearest (ties to even), pow2 (2^n for integral n in
+// [-1022, 1023]), split(y, e, m) (y = 2^e * m, m in [1, 2), for normal y > 0),
+// select_less(x, limit, a, b) (x < limit ? a : b), keep_greater(cand, cand_arg,
+// best, best_arg) and store_index(int*, vec).
+
+// One-lane policy; also runs the tails of the vectorized exp and log.
+struct HmmScalarOps {
+    using vec = double;
+    static constexpr size_t lanes = 1;
+
+    static vec zero() { return 0.0; }
+    static vec set1(double x) { return x; }
+    static vec load(const double* p) { return *p; }
+    static vec loadu(const double* p) { return *p; }
+    static void storeu(double* p, vec v) { *p = v; }
+    static vec add(vec a, vec b) { return a + b; }
+    static vec sub(vec a, vec b) { return a - b; }
+    static vec mul(vec a, vec b) { return a * b; }
+    static vec div(vec a, vec b) { return a / b; }
+    static vec max(vec a, vec b) { return a > b ? a : b; }
+    static vec round_nearest(vec a) { return std::nearbyint(a); }
+    static vec pow2(vec n) { return std::ldexp(1.0, static_cast<int>(n)); }
+    static void split(vec y, vec& e, vec& m) {
+        int k = 0;
+        m = 2.0 * std::frexp(y, &k);
+        e = static_cast<double>(k - 1);
+    }
+    static vec select_less(vec x, vec limit, vec if_less, vec otherwise) { return x < limit ? if_less : otherwise; }
+    static void keep_greater(vec cand, vec cand_arg, vec& best, vec& best_arg) {
+        if (cand > best) { best = cand; best_arg = cand_arg; }
+    }
+    static void store_index(int* p, vec v) { *p = static_cast<int>(v); }
+};
+
+template <class Ops>
+void hmm_mat_vec(const double* M, size_t S, size_t stride, const double* x, double* out) {
+    using V = typename Ops::vec;
+    constexpr size_t W = Ops::lanes;
+    constexpr size_t Blocks = 4;
+    size_t s = 0;
+    for (; s + Blocks * W <= S; s += Blocks * W) {
+        V acc[Blocks];
+        for (size_t b = 0; b < Blocks; ++b) acc[b] = Ops::zero();
+        for (size_t i = 0; i < S; ++i) {
+            const V xi = Ops::set1(x[i]);
+            const double* row = M + i * stride + s;
+            for (size_t b = 0; b < Blocks; ++b) acc[b] = Ops::add(acc[b], Ops::mul(xi, Ops::load(row + b * W)));
+        }
+        for (size_t b = 0; b < Blocks; ++b) Ops::storeu(out + s + b * W, acc[b]);
+    }
+    for (; s + W <= S; s += W) {
+        V acc = Ops::zero();
+        for (size_t i = 0; i < S; ++i) acc = Ops::add(acc, Ops::mul(Ops::set1(x[i]), Ops::load(M + i * stride + s)));
+        Ops::storeu(out + s, acc);
+    }
+    for (; s < S; ++s) {
+        double acc = 0.0;
+        for (size_t i = 0; i < S; ++i) acc += x[i] * M[i * stride + s];
+        out[s] = acc;
+    }
+}
+
+// x[i] (op) M[i][s] for the max reductions below.
+template <class Ops, bool Plus>
+typename Ops::vec combine(typename Ops::vec a, typename Ops::vec b) { return Plus ? Ops::add(a, b) : Ops::mul(a, b); }
+
+// Max-product (Plus = false) or max-plus (Plus = true, log space) reduction.
+// A column with no reachable predecessor (all 0, or all -inf) reports state 0.
+template <class Ops, bool Plus>
+void hmm_max_reduce(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    using V = typename Ops::vec;
+    const double floor = Plus ? -HUGE_VAL : -1.0;
+    constexpr size_t W = Ops::lanes;
+    constexpr size_t Blocks = 4;
+    size_t s = 0;
+    for (; s + Blocks * W <= S; s += Blocks * W) {
+        V best[Blocks], best_arg[Blocks];
+        for (size_t b = 0; b < Blocks; ++b) {
+            best[b] = Ops::set1(floor);
+            best_arg[b] = Ops::zero();
+        }
+        for (size_t i = 0; i < S; ++i) {
+            const V xi = Ops::set1(x[i]);
+            const V vi = Ops::set1(static_cast<double>(i));
+            const double* row = M + i * stride + s;
+            for (size_t b = 0; b < Blocks; ++b) Ops::keep_greater(combine<Ops, Plus>(xi, Ops::load(row + b * W)), vi, best[b], best_arg[b]);
+        }
+        for (size_t b = 0; b < Blocks; ++b) {
+            Ops::storeu(out + s + b * W, best[b]);
+            Ops::store_index(arg + s + b * W, best_arg[b]);
+        }
+    }
+    for (; s + W <= S; s += W) {
+        V best = Ops::set1(floor), best_arg = Ops::zero();
+        for (size_t i = 0; i < S; ++i) {
+            Ops::keep_greater(combine<Ops, Plus>(Ops::set1(x[i]), Ops::load(M + i * stride + s)), Ops::set1(static_cast<double>(i)), best, best_arg);
+        }
+        Ops::storeu(out + s, best);
+        Ops::store_index(arg + s, best_arg);
+    }
+    for (; s < S; ++s) {
+        double best = floor;
+        int best_arg = 0;
+        for (size_t i = 0; i < S; ++i) {
+            const double p = Plus ? x[i] + M[i * stride + s] : x[i] * M[i * stride + s];
+            if (p > best) { best = p; best_arg = static_cast<int>(i); }
+        }
+        out[s] = best;
+        arg[s] = best_arg;
+    }
+}
+
+template <class Ops>
+void hmm_max_vec(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_reduce<Ops, false>(M, S, stride, x, out, arg);
+}
+
+template <class Ops>
+void hmm_max_plus_vec(const double* M, size_t S, size_t stride, const double* x, double* out, int* arg) {
+    hmm_max_reduce<Ops, true>(M, S, stride, x, out, arg);
+}
+
+// exp(x) for x <= 0, flushed to 0 below -708 (where the result leaves the
+// normal range): Cody-Waite reduction to |r| <= ln(2) / 2, a degree-13 Taylor
+// polynomial, then an exact scale by 2^n. Within a few ulp of std::exp and,
+// built from the Ops primitives alone, identical on every ISA.
+template <class Ops>
+typename Ops::vec hmm_exp(typename Ops::vec x) {
+    using V = typename Ops::vec;
+    const V low = Ops::set1(-708.0);
+    const V xc = Ops::max(x, low);
+    const V n = Ops::round_nearest(Ops::mul(xc, Ops::set1(1.4426950408889634)));
+    const V r = Ops::sub(Ops::sub(xc, Ops::mul(n, Ops::set1(6.93147180369123816490e-01))),
+                         Ops::mul(n, Ops::set1(1.90821492927058770002e-10)));
+    static constexpr double inv_fact[14] = {1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040,
+                                            1.0 / 40320, 1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800,
+                                            1.0 / 479001600, 1.0 / 6227020800};
+    V p = Ops::set1(inv_fact[13]);
+    for (int k = 12; k >= 0; --k) p = Ops::add(Ops::mul(p, r), Ops::set1(inv_fact[k]));
+    return Ops::select_less(x, low, Ops::zero(), Ops::mul(p, Ops::pow2(n)));
+}
+
+// log(y) for y >= 0 (log 0 = -inf): y = 2^e * m with m in [sqrt(1/2), sqrt(2)),
+// log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), summed to s^19. Subnormal
+// inputs are scaled into the normal range first.
+template <class Ops>
+typename Ops::vec hmm_log(typename Ops::vec y) {
+    using V = typename Ops::vec;
+    const V tiny = Ops::set1(DBL_MIN);
+    V e, m;
+    Ops::split(Ops::select_less(y, tiny, Ops::mul(y, Ops::set1(0x1p54)), y), e, m);
+    e = Ops::select_less(y, tiny, Ops::sub(e, Ops::set1(54.0)), e);
+    const V root2 = Ops::set1(1.4142135623730951);
+    e = Ops::select_less(m, root2, e, Ops::add(e, Ops::set1(1.0)));
+    m = Ops::select_less(m, root2, m, Ops::mul(m, Ops::set1(0.5)));
+    const V f = Ops::sub(m, Ops::set1(1.0));
+    const V s = Ops::div(f, Ops::add(Ops::set1(2.0), f));
+    const V z = Ops::mul(s, s);
+    V p = Ops::set1(1.0 / 19);
+    for (int k = 17; k >= 3; k -= 2) p = Ops::add(Ops::mul(p, z), Ops::set1(1.0 / k));
+    p = Ops::add(Ops::mul(p, z), Ops::set1(1.0));
+    const V log_m = Ops::mul(Ops::add(s, s), p);
+    const V result = Ops::add(Ops::mul(e, Ops::set1(6.93147180369123816490e-01)),
+                              Ops::add(log_m, Ops::mul(e, Ops::set1(1.90821492927058770002e-10))));
+    return Ops::select_less(y, Ops::set1(DBL_TRUE_MIN), Ops::set1(-HUGE_VAL), result);
+}
+
+// out[i] = exp(x[i] - shift); the tail runs the same arithmetic one lane at a time.
+template <class Ops>
+void hmm_exp_shift(const double* x, double shift, size_t n, double* out) {
+    constexpr size_t W = Ops::lanes;
+    size_t i = 0;
+    for (; i + W <= n; i += W) Ops::storeu(out + i, hmm_exp<Ops>(Ops::sub(Ops::loadu(x + i), Ops::set1(shift))));
+    for (; i < n; ++i) out[i] = hmm_exp<HmmScalarOps>(x[i] - shift);
+}
+
+// out[i] = (base + log(y[i])) + add[i]; out may alias y.
+template <class Ops>
+void hmm_log_add(const double* y, const double* add, double base, size_t n, double* out) {
+    constexpr size_t W = Ops::lanes;
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        Ops::storeu(out + i, Ops::add(Ops::add(Ops::set1(base), hmm_log<Ops>(Ops::loadu(y + i))), Ops::loadu(add + i)));
+    }
+    for (; i < n; ++i) out[i] = (base + hmm_log<HmmScalarOps>(y[i])) + add[i];
+}
+
+// Batched forward step with one sequence per lane. Lane blocks of x are
+// accumulated in registers across the rows of M, then scaled by their
+// emissions: per lane the same operations, in the same order, as hmm_mat_vec
+// followed by DenseHmm's emission product.
+template <class Ops>
+void hmm_batch_forward(const double* M, size_t S, size_t stride, const double* x, const double* emit, size_t lanes, double* out) {
+    using V = typename Ops::vec;
+    constexpr size_t W = Ops::lanes;
+    constexpr size_t Blocks = 4;
+    for (size_t s = 0; s < S; ++s) {
+        const double* e = emit + s * lanes;
+        double* o = out + s * lanes;
+        size_t l = 0;
+        for (; l + Blocks * W <= lanes; l += Blocks * W) {
+            V acc[Blocks];
+            for (size_t b = 0; b < Blocks; ++b) acc[b] = Ops::zero();
+            for (size_t i = 0; i < S; ++i) {
+                const V mi = Ops::set1(M[i * stride + s]);
+                const double* xi = x + i * lanes + l;
+                for (size_t b = 0; b < Blocks; ++b) acc[b] = Ops::add(acc[b], Ops::mul(Ops::loadu(xi + b * W), mi));
+            }
+            for (size_t b = 0; b < Blocks; ++b) Ops::storeu(o + l + b * W, Ops::mul(acc[b], Ops::loadu(e + l + b * W)));
+        }
+        for (; l + W <= lanes; l += W) {
+            V acc = Ops::zero();
+            for (size_t i = 0; i < S; ++i) acc = Ops::add(acc, Ops::mul(Ops::loadu(x + i * lanes + l), Ops::set1(M[i * stride + s])));
+            Ops::storeu(o + l, Ops::mul(acc, Ops::loadu(e + l)));
+        }
+        for (; l < lanes; ++l) {
+            double acc = 0.0;
+            for (size_t i = 0; i < S; ++i) acc += x[i * lanes + l] * M[i * stride + s];
+            o[l] = acc * e[l];
+        }
+    }
+}
+
+} // namespace srf
+
+#endif
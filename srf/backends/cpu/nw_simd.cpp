@@ -0,0 +1,88 @@
+#include "nw_simd.h"
+#include "nw_simd_kernel.h"
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+namespace srf {
+
+bool nw_antidiag_scalar_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<ScalarOps<int16_t>>(s1, s2, match, mismatch, gap, score);
+}
+
+bool nw_antidiag_scalar_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<ScalarOps<int32_t>>(s1, s2, match, mismatch, gap, score);
+}
+
+void nw_intertask_scalar(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                         std::vector<int>& scores, NwSimdReport& report) {
+    nw_intertask<ScalarOps<int16_t>, ScalarOps<int32_t>>(s1, s2, match, mismatch, gap, scores, report);
+}
+
+SimdIsa detect_simd_isa() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (nw_simd_avx512_compiled && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdIsa::AVX512;
+    if (nw_simd_avx2_compiled && __builtin_cpu_supports("avx2")) return SimdIsa::AVX2;
+    if (nw_simd_sse41_compiled && __builtin_cpu_supports("sse4.1")) return SimdIsa::SSE41;
+#endif
+    return SimdIsa::SCALAR;
+}
+
+SimdIsa resolve_simd_isa(SimdIsa requested) {
+    SimdIsa best = detect_simd_isa();
+    return (static_cast<int>(requested) <= static_cast<int>(best)) ? requested : best;
+}
+
+std::string simd_isa_name(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::SSE41: return "sse4.1";
+        case SimdIsa::AVX2: return "avx2";
+        case SimdIsa::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+int nw_simd_score(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, SimdIsa isa, NwSimdReport& report) {
+    using Kernel = bool (*)(const std::string&, const std::string&, int, int, int, int&);
+    Kernel k16 = nw_antidiag_scalar_i16, k32 = nw_antidiag_scalar_i32;
+    isa = resolve_simd_isa(isa);
+    switch (isa) {
+        case SimdIsa::SSE41: k16 = nw_antidiag_sse41_i16; k32 = nw_antidiag_sse41_i32; break;
+        case SimdIsa::AVX2: k16 = nw_antidiag_avx2_i16; k32 = nw_antidiag_avx2_i32; break;
+        case SimdIsa::AVX512: k16 = nw_antidiag_avx512_i16; k32 = nw_antidiag_avx512_i32; break;
+        default: break;
+    }
+    report.isa = isa;
+    report.overflow_fallback = false;
+
+    // Every cell (i, j) lies within max(i, j) * max|score| of zero; skip the 16-bit pass when that cannot fit.
+    long long max_step = std::max({std::abs(match), std::abs(mismatch), std::abs(gap)});
+    long long bound = static_cast<long long>(std::max(s1.length(), s2.length())) * max_step;
+    int score = 0;
+    if (bound < INT16_MAX) {
+        if (k16(s1, s2, match, mismatch, gap, score)) {
+            report.lane_bits = 16;
+            return score;
+        }
+        report.overflow_fallback = true;
+    }
+    k32(s1, s2, match, mismatch, gap, score);
+    report.lane_bits = 32;
+    return score;
+}
+
+void nw_intertask_score(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                        SimdIsa isa, std::vector<int>& scores, NwSimdReport& report) {
+    isa = resolve_simd_isa(isa);
+    report.isa = isa;
+    report.overflow_fallback = false;
+    switch (isa) {
+        case SimdIsa::SSE41: nw_intertask_sse41(s1, s2, match, mismatch, gap, scores, report); break;
+        case SimdIsa::AVX2: nw_intertask_avx2(s1, s2, match, mismatch, gap, scores, report); break;
+        case SimdIsa::AVX512: nw_intertask_avx512(s1, s2, match, mismatch, gap, scores, report); break;
+        default: nw_intertask_scalar(s1, s2, match, mismatch, gap, scores, report); break;
+    }
+}
+
+} // namespace srf
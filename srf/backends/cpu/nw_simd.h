@@ -0,0 +1,64 @@
+#ifndef SRF_BACKENDS_CPU_NW_SIMD_H
+#define SRF_BACKENDS_CPU_NW_SIMD_H
+
+#include <string>
+#include <vector>
+
+namespace srf {
+
+enum class SimdIsa {
+    SCALAR,
+    SSE41,
+    AVX2,
+    AVX512
+};
+
+struct NwSimdReport {
+    SimdIsa isa = SimdIsa::SCALAR;
+    int lane_bits = 0;              // 16 or 32
+    bool overflow_fallback = false; // 16-bit pass saturated and was redone in 32-bit
+};
+
+// Widest ISA that is both compiled in and supported by the running CPU.
+SimdIsa detect_simd_isa();
+
+// Clamps a requested ISA to what is actually available.
+SimdIsa resolve_simd_isa(SimdIsa requested);
+
+std::string simd_isa_name(SimdIsa isa);
+
+// Anti-diagonal vectorized global alignment score with linear gap cost.
+// Runs in 16-bit saturating lanes when the score range allows it and redoes
+// the alignment in 32-bit lanes if any lane saturates.
+int nw_simd_score(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, SimdIsa isa, NwSimdReport& report);
+
+// Per-ISA kernels; each returns false when its lanes saturated or the ISA was not compiled in.
+bool nw_antidiag_scalar_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_scalar_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_sse41_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_sse41_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_avx2_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_avx2_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_avx512_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+bool nw_antidiag_avx512_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score);
+
+// Inter-task kernel: scores[k] = NW(s1[k], s2[k]), one pair per SIMD lane.
+void nw_intertask_score(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                        SimdIsa isa, std::vector<int>& scores, NwSimdReport& report);
+
+void nw_intertask_scalar(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                         std::vector<int>& scores, NwSimdReport& report);
+void nw_intertask_sse41(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                        std::vector<int>& scores, NwSimdReport& report);
+void nw_intertask_avx2(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                       std::vector<int>& scores, NwSimdReport& report);
+void nw_intertask_avx512(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                         std::vector<int>& scores, NwSimdReport& report);
+
+extern const bool nw_simd_sse41_compiled;
+extern const bool nw_simd_avx2_compiled;
+extern const bool nw_simd_avx512_compiled;
+
+} // namespace srf
+
+#endif
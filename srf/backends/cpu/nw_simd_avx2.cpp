@@ -0,0 +1,79 @@
+#include "nw_simd.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include <cstdint>
+#include "nw_simd_kernel.h"
+
+namespace srf {
+
+namespace {
+
+struct Avx2OpsI16 {
+    using lane_t = int16_t;
+    using vec = __m256i;
+    static constexpr int lanes = 16;
+
+    static vec set1(lane_t x) { return _mm256_set1_epi16(x); }
+    static vec loadu(const lane_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void storeu(lane_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static vec add(vec a, vec b) { return _mm256_adds_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+    static vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+    static vec substitution(vec ca, vec cb, vec match, vec mismatch) { return _mm256_blendv_epi8(mismatch, match, _mm256_cmpeq_epi16(ca, cb)); }
+    static lane_t scalar_add(lane_t a, int b) { return ScalarOps<lane_t>::scalar_add(a, b); }
+    static bool saturated(vec v_min, vec v_max) {
+        vec hit = _mm256_or_si256(_mm256_cmpeq_epi16(v_min, set1(INT16_MIN)), _mm256_cmpeq_epi16(v_max, set1(INT16_MAX)));
+        return !_mm256_testz_si256(hit, hit);
+    }
+};
+
+struct Avx2OpsI32 {
+    using lane_t = int32_t;
+    using vec = __m256i;
+    static constexpr int lanes = 8;
+
+    static vec set1(lane_t x) { return _mm256_set1_epi32(x); }
+    static vec loadu(const lane_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void storeu(lane_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+    static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+    static vec substitution(vec ca, vec cb, vec match, vec mismatch) { return _mm256_blendv_epi8(mismatch, match, _mm256_cmpeq_epi32(ca, cb)); }
+    static lane_t scalar_add(lane_t a, int b) { return ScalarOps<lane_t>::scalar_add(a, b); }
+    static bool saturated(vec, vec) { return false; }
+};
+
+} // namespace
+
+const bool nw_simd_avx2_compiled = true;
+
+bool nw_antidiag_avx2_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<Avx2OpsI16>(s1, s2, match, mismatch, gap, score);
+}
+
+bool nw_antidiag_avx2_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<Avx2OpsI32>(s1, s2, match, mismatch, gap, score);
+}
+
+void nw_intertask_avx2(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                        std::vector<int>& scores, NwSimdReport& report) {
+    nw_intertask<Avx2OpsI16, Avx2OpsI32>(s1, s2, match, mismatch, gap, scores, report);
+}
+
+} // namespace srf
+
+#else
+
+namespace srf {
+
+const bool nw_simd_avx2_compiled = false;
+
+bool nw_antidiag_avx2_i16(const std::string&, const std::string&, int, int, int, int&) { return false; }
+bool nw_antidiag_avx2_i32(const std::string&, const std::string&, int, int, int, int&) { return false; }
+void nw_intertask_avx2(const std::vector<std::string>&, const std::vector<std::string>&, int, int, int,
+                        std::vector<int>& scores, NwSimdReport&) { scores.clear(); }
+
+} // namespace srf
+
+#endif
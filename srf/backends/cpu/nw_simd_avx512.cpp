@@ -0,0 +1,78 @@
+#include "nw_simd.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+#include <cstdint>
+#include "nw_simd_kernel.h"
+
+namespace srf {
+
+namespace {
+
+struct Avx512OpsI16 {
+    using lane_t = int16_t;
+    using vec = __m512i;
+    static constexpr int lanes = 32;
+
+    static vec set1(lane_t x) { return _mm512_set1_epi16(x); }
+    static vec loadu(const lane_t* p) { return _mm512_loadu_si512(p); }
+    static void storeu(lane_t* p, vec v) { _mm512_storeu_si512(p, v); }
+    static vec add(vec a, vec b) { return _mm512_adds_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_epi16(a, b); }
+    static vec min(vec a, vec b) { return _mm512_min_epi16(a, b); }
+    static vec substitution(vec ca, vec cb, vec match, vec mismatch) { return _mm512_mask_blend_epi16(_mm512_cmpeq_epi16_mask(ca, cb), mismatch, match); }
+    static lane_t scalar_add(lane_t a, int b) { return ScalarOps<lane_t>::scalar_add(a, b); }
+    static bool saturated(vec v_min, vec v_max) {
+        return (_mm512_cmpeq_epi16_mask(v_min, set1(INT16_MIN)) | _mm512_cmpeq_epi16_mask(v_max, set1(INT16_MAX))) != 0;
+    }
+};
+
+struct Avx512OpsI32 {
+    using lane_t = int32_t;
+    using vec = __m512i;
+    static constexpr int lanes = 16;
+
+    static vec set1(lane_t x) { return _mm512_set1_epi32(x); }
+    static vec loadu(const lane_t* p) { return _mm512_loadu_si512(p); }
+    static void storeu(lane_t* p, vec v) { _mm512_storeu_si512(p, v); }
+    static vec add(vec a, vec b) { return _mm512_add_epi32(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_epi32(a, b); }
+    static vec min(vec a, vec b) { return _mm512_min_epi32(a, b); }
+    static vec substitution(vec ca, vec cb, vec match, vec mismatch) { return _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(ca, cb), mismatch, match); }
+    static lane_t scalar_add(lane_t a, int b) { return ScalarOps<lane_t>::scalar_add(a, b); }
+    static bool saturated(vec, vec) { return false; }
+};
+
+} // namespace
+
+const bool nw_simd_avx512_compiled = true;
+
+bool nw_antidiag_avx512_i16(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<Avx512OpsI16>(s1, s2, match, mismatch, gap, score);
+}
+
+bool nw_antidiag_avx512_i32(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    return nw_antidiagonal<Avx512OpsI32>(s1, s2, match, mismatch, gap, score);
+}
+
+void nw_intertask_avx512(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                        std::vector<int>& scores, NwSimdReport& report) {
+    nw_intertask<Avx512OpsI16, Avx512OpsI32>(s1, s2, match, mismatch, gap, scores, report);
+}
+
+} // namespace srf
+
+#else
+
+namespace srf {
+
+const bool nw_simd_avx512_compiled = false;
+
+bool nw_antidiag_avx512_i16(const std::string&, const std::string&, int, int, int, int&) { return false; }
+bool nw_antidiag_avx512_i32(const std::string&, const std::string&, int, int, int, int&) { return false; }
+void nw_intertask_avx512(const std::vector<std::string>&, const std::vector<std::string>&, int, int, int,
+                        std::vector<int>& scores, NwSimdReport&) { scores.clear(); }
+
+} // namespace srf
+
+#endif
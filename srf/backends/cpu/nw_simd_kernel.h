@@ -0,0 +1,215 @@
+#ifndef SRF_BACKENDS_CPU_NW_SIMD_KERNEL_H
+#define SRF_BACKENDS_CPU_NW_SIMD_KERNEL_H
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include "nw_simd.h"
+
+namespace srf {
+
+// Anti-diagonal Needleman-Wunsch over an ISA-specific Ops policy.
+//
+// Cells on diagonal k = i + j are independent, so they are indexed by row i
+// and processed Ops::lanes at a time. Three diagonal buffers (k-2, k-1, k) are
+// kept; s2 is stored reversed so that s2[k - i - 1] is contiguous in i.
+// Ops must provide: lane_t, vec, lanes, set1, loadu, storeu, add, max, min,
+// substitution(ca, cb, match, mismatch), scalar_add and saturated(vmin, vmax).
+template <class Ops>
+bool nw_antidiagonal(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, int& score) {
+    using T = typename Ops::lane_t;
+    using V = typename Ops::vec;
+    constexpr long long W = Ops::lanes;
+    const long long n = s1.length();
+    const long long m = s2.length();
+    if (n == 0 || m == 0) {
+        score = static_cast<int>((n + m) * gap);
+        return true;
+    }
+
+    std::vector<T> a(n), b(m);
+    for (long long i = 0; i < n; ++i) a[i] = static_cast<T>(static_cast<unsigned char>(s1[i]));
+    for (long long t = 0; t < m; ++t) b[t] = static_cast<T>(static_cast<unsigned char>(s2[m - 1 - t]));
+
+    std::vector<T> buf0(n + 1), buf1(n + 1), buf2(n + 1);
+    T* d0 = buf0.data();
+    T* d1 = buf1.data();
+    T* d2 = buf2.data();
+    d1[0] = 0;
+
+    const V v_match = Ops::set1(static_cast<T>(match));
+    const V v_mismatch = Ops::set1(static_cast<T>(mismatch));
+    const V v_gap = Ops::set1(static_cast<T>(gap));
+    V v_min = Ops::set1(0), v_max = Ops::set1(0);
+    T s_min = 0, s_max = 0;
+
+    for (long long k = 1; k <= n + m; ++k) {
+        if (k <= m) {
+            d2[0] = Ops::scalar_add(0, static_cast<int>(k * gap));
+            s_min = std::min(s_min, d2[0]);
+        }
+        if (k <= n) {
+            d2[k] = Ops::scalar_add(0, static_cast<int>(k * gap));
+            s_min = std::min(s_min, d2[k]);
+        }
+
+        const long long lo = std::max(1LL, k - m);
+        const long long hi = std::min(n, k - 1);
+        // b index of cell (i, k - i); i >= k - m keeps it non-negative, so the offset is added to i
+        // before forming a pointer (b.data() + (m - k) alone would point before the array).
+        const long long shift = m - k;
+        long long i = lo;
+        for (; i + W - 1 <= hi; i += W) {
+            V diag = Ops::loadu(d0 + i - 1);
+            V top = Ops::loadu(d1 + i - 1);
+            V left = Ops::loadu(d1 + i);
+            V sub = Ops::substitution(Ops::loadu(a.data() + i - 1), Ops::loadu(b.data() + (i + shift)), v_match, v_mismatch);
+            V h = Ops::max(Ops::add(diag, sub), Ops::max(Ops::add(top, v_gap), Ops::add(left, v_gap)));
+            Ops::storeu(d2 + i, h);
+            v_min = Ops::min(v_min, h);
+            v_max = Ops::max(v_max, h);
+        }
+        for (; i <= hi; ++i) {
+            int sub = (a[i - 1] == b[i + shift]) ? match : mismatch;
+            T h = std::max({Ops::scalar_add(d0[i - 1], sub), Ops::scalar_add(d1[i - 1], gap), Ops::scalar_add(d1[i], gap)});
+            d2[i] = h;
+            s_min = std::min(s_min, h);
+            s_max = std::max(s_max, h);
+        }
+
+        T* recycled = d0;
+        d0 = d1;
+        d1 = d2;
+        d2 = recycled;
+    }
+
+    // Narrow lanes clamp instead of wrapping, so touching either limit means the score may be wrong.
+    if (sizeof(T) < sizeof(int) &&
+        (Ops::saturated(v_min, v_max) || s_min == std::numeric_limits<T>::min() || s_max == std::numeric_limits<T>::max())) {
+        return false;
+    }
+    score = static_cast<int>(d1[n]);
+    return true;
+}
+
+// Inter-task Needleman-Wunsch for up to Ops::lanes pairs at once (one pair per lane).
+//
+// Sequences are transposed so that position i of every pair in the batch is one
+// vector; shorter pairs are padded with codes that never match. Padding cannot
+// change a lane's result because cell (n_l, m_l) only depends on cells above and
+// to the left of it, so each lane is read out of row n_l at column m_l.
+template <class Ops>
+bool nw_intertask_batch(const std::vector<std::string>& s1, const std::vector<std::string>& s2, const size_t* idx, size_t count,
+                        int match, int mismatch, int gap, std::vector<int>& scores) {
+    using T = typename Ops::lane_t;
+    using V = typename Ops::vec;
+    constexpr size_t L = Ops::lanes;
+    const T pad_a = static_cast<T>(-1), pad_b = static_cast<T>(-2);
+
+    size_t N = 0, M = 0;
+    for (size_t l = 0; l < count; ++l) {
+        N = std::max(N, s1[idx[l]].length());
+        M = std::max(M, s2[idx[l]].length());
+    }
+    std::vector<T> A(std::max<size_t>(N, 1) * L, pad_a), Bv(std::max<size_t>(M, 1) * L, pad_b), H((M + 1) * L);
+    for (size_t l = 0; l < count; ++l) {
+        const std::string& a = s1[idx[l]];
+        const std::string& b = s2[idx[l]];
+        for (size_t i = 0; i < a.length(); ++i) A[i * L + l] = static_cast<T>(static_cast<unsigned char>(a[i]));
+        for (size_t j = 0; j < b.length(); ++j) Bv[j * L + l] = static_cast<T>(static_cast<unsigned char>(b[j]));
+    }
+
+    // Lanes grouped by the row on which their result becomes final.
+    std::vector<std::vector<size_t>> ends_at(N + 1);
+    for (size_t l = 0; l < count; ++l) ends_at[s1[idx[l]].length()].push_back(l);
+
+    for (size_t j = 0; j <= M; ++j) Ops::storeu(H.data() + j * L, Ops::set1(Ops::scalar_add(0, static_cast<int>(j) * gap)));
+    for (size_t l : ends_at[0]) scores[idx[l]] = H[s2[idx[l]].length() * L + l];
+
+    const V v_match = Ops::set1(static_cast<T>(match));
+    const V v_mismatch = Ops::set1(static_cast<T>(mismatch));
+    const V v_gap = Ops::set1(static_cast<T>(gap));
+    V v_min = Ops::set1(0), v_max = Ops::set1(0);
+
+    for (size_t i = 1; i <= N; ++i) {
+        V diag = Ops::loadu(H.data());
+        V left = Ops::set1(Ops::scalar_add(0, static_cast<int>(i) * gap));
+        Ops::storeu(H.data(), left);
+        const V av = Ops::loadu(A.data() + (i - 1) * L);
+        for (size_t j = 1; j <= M; ++j) {
+            V up = Ops::loadu(H.data() + j * L);
+            V sub = Ops::substitution(av, Ops::loadu(Bv.data() + (j - 1) * L), v_match, v_mismatch);
+            V h = Ops::max(Ops::add(diag, sub), Ops::max(Ops::add(up, v_gap), Ops::add(left, v_gap)));
+            Ops::storeu(H.data() + j * L, h);
+            v_min = Ops::min(v_min, h);
+            v_max = Ops::max(v_max, h);
+            diag = up;
+            left = h;
+        }
+        for (size_t l : ends_at[i]) scores[idx[l]] = H[s2[idx[l]].length() * L + l];
+    }
+    return sizeof(T) >= sizeof(int) || !Ops::saturated(v_min, v_max);
+}
+
+// Sorts pairs by length so each batch pads as little as possible, then runs
+// batches in 16-bit lanes when their score range allows and in 32-bit otherwise.
+template <class Ops16, class Ops32>
+void nw_intertask(const std::vector<std::string>& s1, const std::vector<std::string>& s2, int match, int mismatch, int gap,
+                  std::vector<int>& scores, NwSimdReport& report) {
+    const size_t P = std::min(s1.size(), s2.size());
+    scores.assign(P, 0);
+    std::vector<size_t> order(P);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return std::make_pair(s1[x].length(), s2[x].length()) < std::make_pair(s1[y].length(), s2[y].length());
+    });
+
+    const long long max_step = std::max({std::abs(match), std::abs(mismatch), std::abs(gap)});
+    report.lane_bits = 16;
+    for (size_t start = 0; start < P;) {
+        size_t count = std::min<size_t>(Ops16::lanes, P - start);
+        size_t longest = 0;
+        for (size_t l = 0; l < count; ++l) longest = std::max({longest, s1[order[start + l]].length(), s2[order[start + l]].length()});
+        bool narrow = static_cast<long long>(longest) * max_step < std::numeric_limits<typename Ops16::lane_t>::max();
+        if (narrow && nw_intertask_batch<Ops16>(s1, s2, order.data() + start, count, match, mismatch, gap, scores)) {
+            start += count;
+            continue;
+        }
+        if (narrow) report.overflow_fallback = true;
+        report.lane_bits = 32;
+        count = std::min<size_t>(Ops32::lanes, P - start);
+        nw_intertask_batch<Ops32>(s1, s2, order.data() + start, count, match, mismatch, gap, scores);
+        start += count;
+    }
+}
+
+// Single-lane policy used as the portable fallback and for the scalar tail semantics.
+template <class T>
+struct ScalarOps {
+    using lane_t = T;
+    using vec = T;
+    static constexpr int lanes = 1;
+
+    static vec set1(T x) { return x; }
+    static vec loadu(const T* p) { return *p; }
+    static void storeu(T* p, vec v) { *p = v; }
+    static vec add(vec a, vec b) { return scalar_add(a, b); }
+    static vec max(vec a, vec b) { return std::max(a, b); }
+    static vec min(vec a, vec b) { return std::min(a, b); }
+    static vec substitution(vec ca, vec cb, vec match, vec mismatch) { return (ca == cb) ? match : mismatch; }
+    static T scalar_add(T a, int b) {
+        long long r = static_cast<long long>(a) + b;
+        r = std::max<long long>(r, std::numeric_limits<T>::min());
+        r = std::min<long long>(r, std::numeric_limits<T>::max());
+        return static_cast<T>(r);
+    }
+    static bool saturated(vec v_min, vec v_max) {
+        return v_min == std::numeric_limits<T>::min() || v_max == std::numeric_limits<T>::max();
+    }
+};
+
+} // namespace srf
+
+#endif
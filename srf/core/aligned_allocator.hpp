@@ -0,0 +1,45 @@
+#ifndef SRF_CORE_ALIGNED_ALLOCATOR_HPP
+#define SRF_CORE_ALIGNED_ALLOCATOR_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace srf {
+
+// Allocator returning Align-byte aligned storage (a cache line by default), so
+// vectorized kernels can stream rows without split loads.
+template <typename T, size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        size_t bytes = ((n * sizeof(T) + Align - 1) / Align) * Align;
+        void* p = std::aligned_alloc(Align, bytes > 0 ? bytes : Align);
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) { std::free(p); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SRF_CORE_MAPPED_FILE_HPP
+#define SRF_CORE_MAPPED_FILE_HPP
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+#define SRF_MAPPED_FILE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace srf {
+
+// Read-only view of a whole file: memory-mapped where mmap exists, otherwise
+// read into an 8-byte aligned buffer. data() stays valid until close().
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path, std::string& error) {
+        close();
+#ifdef SRF_MAPPED_FILE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open " + path; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            error = "cannot stat " + path;
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                error = "cannot map " + path;
+                return false;
+            }
+            map_ = p;
+            data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+        open_ = true;
+#else
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) { error = "cannot open " + path; return false; }
+        std::fseek(f, 0, SEEK_END);
+        size_ = static_cast<size_t>(std::ftell(f));
+        std::fseek(f, 0, SEEK_SET);
+        buffer_.resize((size_ + 7) / 8);
+        const bool read = std::fread(buffer_.data(), 1, size_, f) == size_;
+        std::fclose(f);
+        if (!read) {
+            close();
+            error = "cannot read " + path;
+            return false;
+        }
+        data_ = reinterpret_cast<const char*>(buffer_.data());
+        open_ = true;
+#endif
+        return true;
+    }
+
+    // Hints that the mapping will be read front to back.
+    void advise_sequential() const {
+#ifdef SRF_MAPPED_FILE_MMAP
+        if (map_) madvise(map_, size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+    void close() {
+#ifdef SRF_MAPPED_FILE_MMAP
+        if (map_) munmap(map_, size_);
+        map_ = nullptr;
+#else
+        buffer_.clear();
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+#ifdef SRF_MAPPED_FILE_MMAP
+    void* map_ = nullptr;
+#else
+    std::vector<uint64_t> buffer_;
+#endif
+};
+
+} // namespace srf
+
+#endif
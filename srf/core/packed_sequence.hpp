@@ -0,0 +1,208 @@
+#ifndef SRF_CORE_PACKED_SEQUENCE_HPP
+#define SRF_CORE_PACKED_SEQUENCE_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include "sequence_parser.hpp"
+
+namespace srf {
+
+// DNA sequence packed 2 bits per base (A=0, C=1, G=2, T=3), 32 bases per word,
+// base k of a word in bits [2k, 2k+1]. Any other byte (N, IUPAC codes, lower
+// case) is an exception: it is flagged in a 1-bit-per-base mask and its exact
+// byte kept in a sorted list of runs (start, length, byte), so comparisons stay
+// identical to comparing the original characters and an N block of any length
+// costs one 16-byte run. The mask is only allocated once an exception occurs,
+// so pure ACGT input costs n/4 bytes.
+class PackedSequence {
+public:
+    // One base of the other sequence, decoded once and reused for a whole row.
+    struct Query {
+        uint8_t code = 0;
+        bool exception = false;
+        char raw = 'A';
+    };
+
+    PackedSequence() = default;
+
+    static PackedSequence from_string(const std::string& s) {
+        PackedSequence p;
+        p.reserve(s.length());
+        for (char c : s) p.push_back(c);
+        return p;
+    }
+
+    void reserve(size_t n) { words_.reserve((n + 31) / 32); }
+
+    void push_back(char c) {
+        const size_t k = size_;
+        if (k % 32 == 0) words_.push_back(0);
+        uint8_t code = encode(c);
+        if (code > 3) {
+            if (exception_bits_.size() * 64 < k + 1) exception_bits_.resize(words_.size() / 2 + 1, 0);
+            exception_bits_[k / 64] |= 1ULL << (k % 64);
+            if (!exceptions_.empty() && exceptions_.back().c == c &&
+                exceptions_.back().start + exceptions_.back().length == k &&
+                exceptions_.back().length < UINT32_MAX) {
+                ++exceptions_.back().length;
+            } else {
+                exceptions_.push_back({k, 1, c});
+            }
+            ++exception_count_;
+            code = 0;
+        }
+        words_.back() |= static_cast<uint64_t>(code) << (2 * (k % 32));
+        ++size_;
+    }
+
+    size_t size() const { return size_; }
+    size_t length() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t exception_count() const { return exception_count_; }
+    size_t exception_run_count() const { return exceptions_.size(); }
+
+    // Heap bytes held by the packed representation.
+    size_t bytes() const {
+        return words_.size() * sizeof(uint64_t) + exception_bits_.size() * sizeof(uint64_t) +
+               exceptions_.size() * sizeof(ExceptionRun);
+    }
+
+    bool is_exception(size_t i) const {
+        return !exception_bits_.empty() && i / 64 < exception_bits_.size() && ((exception_bits_[i / 64] >> (i % 64)) & 1);
+    }
+
+    char at(size_t i) const {
+        if (is_exception(i)) {
+            auto it = run_containing(i);
+            if (it != exceptions_.end() && it->start <= i) return it->c;
+        }
+        return "ACGT"[(words_[i / 32] >> (2 * (i % 32))) & 3];
+    }
+
+    Query query(size_t i) const { return query_for(at(i)); }
+
+    // Query for a base that is not stored in any sequence (e.g. one streamed in).
+    static Query query_for(char c) {
+        Query q;
+        q.raw = c;
+        q.code = encode(c);
+        q.exception = q.code > 3;
+        if (q.exception) q.code = 0;
+        return q;
+    }
+
+    std::string unpack() const {
+        std::string s;
+        s.reserve(size_);
+        for (size_t i = 0; i < size_; ++i) s += at(i);
+        return s;
+    }
+
+    // Bit k set iff base (32 * w + k) equals q. Bits past the end are clear.
+    uint32_t match_word(size_t w, const Query& q) const {
+        if (w >= words_.size()) return 0;
+        uint64_t eq = 0;
+        if (q.exception) {
+            eq = exception_matches(w, q.raw);
+        } else {
+            // XOR leaves 00 in matching fields; fold each field to its low bit, then compact.
+            uint64_t x = words_[w] ^ (0x5555555555555555ULL * q.code);
+            uint64_t z = ~(x | (x >> 1)) & 0x5555555555555555ULL;
+            z = (z | (z >> 1)) & 0x3333333333333333ULL;
+            z = (z | (z >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+            z = (z | (z >> 4)) & 0x00FF00FF00FF00FFULL;
+            z = (z | (z >> 8)) & 0x0000FFFF0000FFFFULL;
+            z = (z | (z >> 16)) & 0x00000000FFFFFFFFULL;
+            eq = z & ~exception_word(w);
+        }
+        const size_t valid = size_ - 32 * w;
+        if (valid < 32) eq &= (1ULL << valid) - 1;
+        return static_cast<uint32_t>(eq);
+    }
+
+    // Bit k set iff base (j0 + k) equals q, for 64 bases starting at any offset.
+    uint64_t match_mask(size_t j0, const Query& q) const {
+        const size_t w = j0 / 32;
+        const unsigned off = static_cast<unsigned>(j0 % 32);
+        uint64_t lo = static_cast<uint64_t>(match_word(w, q)) | (static_cast<uint64_t>(match_word(w + 1, q)) << 32);
+        if (off == 0) return lo;
+        return (lo >> off) | (static_cast<uint64_t>(match_word(w + 2, q)) << (64 - off));
+    }
+
+private:
+    // Consecutive exception bases holding the same byte.
+    struct ExceptionRun {
+        size_t start;
+        uint32_t length;
+        char c;
+    };
+
+    static uint8_t encode(char c) {
+        switch (c) {
+            case 'A': return 0;
+            case 'C': return 1;
+            case 'G': return 2;
+            case 'T': return 3;
+            default: return 4;
+        }
+    }
+
+    // Exception flags for bases [32w, 32w + 32), in the low 32 bits.
+    uint64_t exception_word(size_t w) const {
+        if (exception_bits_.empty() || w / 2 >= exception_bits_.size()) return 0;
+        return (exception_bits_[w / 2] >> (32 * (w % 2))) & 0xFFFFFFFFULL;
+    }
+
+    // First run ending after position i (the run holding i, if any). Runs are disjoint and
+    // sorted, so their ends are sorted too; the search never compares the byte.
+    std::vector<ExceptionRun>::const_iterator run_containing(size_t i) const {
+        return std::lower_bound(exceptions_.begin(), exceptions_.end(), i,
+                                [](const ExceptionRun& e, size_t pos) { return e.start + e.length <= pos; });
+    }
+
+    uint64_t exception_matches(size_t w, char raw) const {
+        uint64_t eq = 0;
+        const size_t lo = 32 * w, hi = 32 * (w + 1);
+        auto it = run_containing(lo);
+        for (; it != exceptions_.end() && it->start < hi; ++it) {
+            if (it->c != raw) continue;
+            const size_t b = std::max(it->start, lo) - lo;
+            const size_t e = std::min<size_t>(it->start + it->length, hi) - lo;
+            eq |= ((1ULL << (e - b)) - 1) << b;  // e - b <= 32
+        }
+        return eq;
+    }
+
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> exception_bits_;
+    std::vector<ExceptionRun> exceptions_;
+    size_t exception_count_ = 0;
+    size_t size_ = 0;
+};
+
+// Reads a file's sequence (the first token, or the first FASTA record; see
+// SequenceParser) straight into packed form, without an intermediate string.
+inline PackedSequence load_packed_sequence(const std::string& path) {
+    PackedSequence seq;
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return seq;
+    f.seekg(0, std::ios::end);
+    std::streamoff size = f.tellg();
+    f.seekg(0, std::ios::beg);
+    if (size > 0) seq.reserve(static_cast<size_t>(size));
+
+    std::vector<char> buf(1 << 16);
+    SequenceParser parser;
+    while (f && !parser.finished()) {
+        f.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        parser.feed(buf.data(), static_cast<size_t>(f.gcount()), seq);
+    }
+    return seq;
+}
+
+} // namespace srf
+
+#endif
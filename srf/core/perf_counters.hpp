@@ -0,0 +1,92 @@
+#ifndef SRF_CORE_PERF_COUNTERS_HPP
+#define SRF_CORE_PERF_COUNTERS_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace srf {
+
+// Hardware cache-miss counters around a code region (Linux perf_event_open).
+// L2 misses have no portable generic event; last-level-cache references are
+// the requests that missed L2, so they serve as the L2 miss count. Counters
+// that cannot be opened (no PMU, VM, perf_event_paranoid) read as -1.
+class CacheCounters {
+public:
+    enum Event { L1D_MISSES = 0, L2_MISSES, LLC_MISSES, EVENT_COUNT };
+
+    CacheCounters() {
+        for (int e = 0; e < EVENT_COUNT; ++e) fds_[e] = -1;
+#if defined(__linux__)
+        const uint32_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        fds_[L1D_MISSES] = open_counter(PERF_TYPE_HW_CACHE, l1d_read_miss);
+        fds_[L2_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+        fds_[LLC_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~CacheCounters() {
+#if defined(__linux__)
+        for (int e = 0; e < EVENT_COUNT; ++e) if (fds_[e] >= 0) close(fds_[e]);
+#endif
+    }
+
+    CacheCounters(const CacheCounters&) = delete;
+    CacheCounters& operator=(const CacheCounters&) = delete;
+
+    void start() {
+#if defined(__linux__)
+        for (int e = 0; e < EVENT_COUNT; ++e) {
+            if (fds_[e] < 0) continue;
+            ioctl(fds_[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds_[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#if defined(__linux__)
+        for (int e = 0; e < EVENT_COUNT; ++e) {
+            if (fds_[e] < 0) continue;
+            ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (read(fds_[e], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) values_[e] = value;
+        }
+#endif
+    }
+
+    long long value(Event e) const { return (fds_[e] >= 0) ? values_[e] : -1; }
+
+    // Counter value, or "NA" when the event is unavailable.
+    std::string str(Event e) const { return (fds_[e] >= 0) ? std::to_string(values_[e]) : "NA"; }
+
+private:
+#if defined(__linux__)
+    static int open_counter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    int fds_[EVENT_COUNT];
+    long long values_[EVENT_COUNT] = {0, 0, 0};
+};
+
+} // namespace srf
+
+#endif
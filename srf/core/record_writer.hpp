@@ -0,0 +1,58 @@
+#ifndef SRF_CORE_RECORD_WRITER_HPP
+#define SRF_CORE_RECORD_WRITER_HPP
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+namespace srf {
+
+// Writes fixed-width records that are produced in descending index order (as
+// by a backward pass) to their final file positions. Runs of records are
+// gathered back to front in a buffer, so each flush is one seek and one write.
+class DescendingRecordWriter {
+public:
+    DescendingRecordWriter(const std::string& path, size_t record_bytes, size_t buffer_records = 4096)
+        : record_(record_bytes), capacity_(buffer_records > 0 ? buffer_records : 1),
+          buffer_(capacity_ * record_bytes), free_(capacity_) {
+        if (!path.empty()) file_ = std::fopen(path.c_str(), "wb");
+    }
+
+    ~DescendingRecordWriter() {
+        flush();
+        if (file_) std::fclose(file_);
+    }
+
+    DescendingRecordWriter(const DescendingRecordWriter&) = delete;
+    DescendingRecordWriter& operator=(const DescendingRecordWriter&) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // Record for index; each call's index must be one below the previous one.
+    void put(size_t index, const char* record) {
+        if (!file_) return;
+        if (free_ == 0) flush();
+        std::memcpy(&buffer_[--free_ * record_], record, record_);
+        low_ = index;
+    }
+
+    void flush() {
+        if (!file_ || free_ == capacity_) return;
+        std::fseek(file_, static_cast<long>(low_ * record_), SEEK_SET);
+        std::fwrite(&buffer_[free_ * record_], 1, (capacity_ - free_) * record_, file_);
+        free_ = capacity_;
+    }
+
+private:
+    std::FILE* file_ = nullptr;
+    size_t record_;
+    size_t capacity_;
+    std::vector<char> buffer_;
+    size_t free_;       // Slots [free_, capacity_) hold records low_, low_ + 1, ...
+    size_t low_ = 0;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef SRF_CORE_SEQUENCE_PARSER_HPP
+#define SRF_CORE_SEQUENCE_PARSER_HPP
+
+#include <cstddef>
+
+namespace srf {
+
+// Incremental parser for the one sequence a sequence file holds, shared by
+// the whole-file loaders and the streaming prefetcher so both read the same
+// bases. Plain input yields its first whitespace-delimited token (what
+// `f >> s` reads). FASTA input (a '>' before the first base) yields the first
+// record's lines joined, up to the next '>' at a line start. Input may be fed
+// in pieces of any size; the result does not depend on where they split.
+class SequenceParser {
+public:
+    bool finished() const { return finished_; }
+
+    // Parses bytes [p, p + n), appending bases to out until it holds limit
+    // bases or the sequence ends. Returns the number of bytes consumed.
+    template <class Out>
+    size_t feed(const char* p, size_t n, Out& out, size_t limit = static_cast<size_t>(-1)) {
+        size_t k = 0;
+        for (; k < n && !finished_ && out.size() < limit; ++k) {
+            const char c = p[k];
+            const bool newline = (c == '\n' || c == '\r');
+            const bool space = newline || c == ' ' || c == '\t' || c == '\v' || c == '\f';
+            if (in_header_) {
+                if (newline) in_header_ = false;
+            } else if (!started_ && c == '>') {
+                fasta_ = in_header_ = true;
+            } else if (fasta_ && at_line_start_ && c == '>') {
+                finished_ = true;  // Next record: the first one is complete.
+            } else if (space) {
+                if (started_ && !fasta_) finished_ = true;  // End of the first token.
+            } else {
+                started_ = true;
+                out.push_back(c);
+            }
+            at_line_start_ = newline;
+        }
+        return k;
+    }
+
+private:
+    bool started_ = false;
+    bool fasta_ = false;
+    bool in_header_ = false;
+    bool at_line_start_ = true;
+    bool finished_ = false;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SRF_CORE_CLI_HPP
+#define SRF_CORE_CLI_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace srf {
+
+// Command line split into the positional arguments used by the benchmark
+// scripts and trailing "--name value" / "--name=value" options.
+struct CliArgs {
+    std::vector<std::string> positional;
+    std::map<std::string, std::string> options;
+
+    bool has(const std::string& name) const { return options.count(name) > 0; }
+
+    std::string get(const std::string& name, const std::string& fallback) const {
+        auto it = options.find(name);
+        return (it != options.end()) ? it->second : fallback;
+    }
+
+    int get_int(const std::string& name, int fallback) const {
+        auto it = options.find(name);
+        return (it != options.end()) ? std::stoi(it->second) : fallback;
+    }
+
+    std::string arg(size_t idx, const std::string& fallback = "") const {
+        return (idx < positional.size() && !positional[idx].empty()) ? positional[idx] : fallback;
+    }
+};
+
+// An option without a value (last argument, or followed by another option) is stored as "1".
+inline CliArgs parse_cli(int argc, char* argv[]) {
+    CliArgs args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.size() > 2 && a.compare(0, 2, "--") == 0) {
+            std::string name = a.substr(2);
+            std::string value = "1";
+            size_t eq = name.find('=');
+            if (eq != std::string::npos) {
+                value = name.substr(eq + 1);
+                name = name.substr(0, eq);
+            } else if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+                value = argv[++i];
+            }
+            args.options[name] = value;
+        } else {
+            args.positional.push_back(a);
+        }
+    }
+    return args;
+}
+
+} // namespace srf
+
+#endif
@@ -11,6 +11,7 @@
 #include <psapi.h>
 #elif defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
 #include <sys/resource.h>
+#include <unistd.h>
 #endif
 
 namespace srf {
@@ -43,15 +44,15 @@ struct Metrics {
         memory_access_proxy = 0;
         dispatch_overhead_proxy = 0;
     }
-    void record_recompute(int count = 1) { recompute_events += count; compute_events += count; }
-    void record_compute(int count = 1) { compute_events += count; }
-    void record_mem_access() { memory_access_proxy++; }
+    void record_recompute(long long count = 1) { recompute_events += count; compute_events += count; }
+    void record_compute(long long count = 1) { compute_events += count; }
+    void record_mem_access(long long count = 1) { memory_access_proxy += count; }
     
     void update_working_set(size_t bytes) {
         long long current = working_set_bytes;
         while (bytes > (size_t)current && !working_set_bytes.compare_exchange_weak(current, (long long)bytes));
     }
-    void record_reuse() { tile_reuse_count++; memory_access_proxy++; }
+    void record_reuse(long long count = 1) { tile_reuse_count += count; memory_access_proxy += count; }
     void record_dist(long long d) { total_dist_metric += d; }
 
     void record_unit_recompute(long long unit_id) {
@@ -81,6 +82,15 @@ struct CacheModel {
         int side = static_cast<int>(std::sqrt(budget_bytes / cell_size));
         return (side > 2) ? side : 2;
     }
+
+    // L2 size reported by the OS, or fallback_kb when it is unknown.
+    static size_t l2_budget_kb(size_t fallback_kb = 256) {
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+        long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (bytes > 0) return static_cast<size_t>(bytes) / 1024;
+#endif
+        return fallback_kb;
+    }
 };
 
 size_t get_peak_rss() {
@@ -3,52 +3,59 @@
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
 #include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
+#include "../core/record_writer.hpp"
 #include "../runtime/backend_selector.h"
+#include "../runtime/thread_pool.h"
 #include "../granularity/granularity_policy.h"
 #include "../control/drift_detector.h"
 #include "../control/adaptation_policy.h"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+#include "hmm_posterior.h"
+#include "hmm_time_parallel.h"
 
-enum Observation { Walk, Shop, Clean, OBS_UNKNOWN };
-
-Observation char_to_obs(char c) {
-    if (c == 'A') return Walk;
-    if (c == 'C') return Shop;
-    if (c == 'G') return Clean;
-    return OBS_UNKNOWN;
-}
-
-std::vector<Observation> load_observations(const std::string& path) {
-    std::ifstream f(path);
-    std::string s;
-    f >> s;
-    std::vector<Observation> obs;
-    for(char c : s) obs.push_back(char_to_obs(c));
-    return obs;
-}
-
-double forward_granularity_aware(const std::vector<Observation>& obs, int K_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
-    double start_p[] = {0.6, 0.4};
-    double trans_p[2][2] = {{0.7, 0.3}, {0.4, 0.6}};
-    double emit_p[2][4] = {{0.1, 0.4, 0.4, 0.1}, {0.6, 0.2, 0.1, 0.1}};
+// Runs the Forward recursion on the dense kernels: two ping-pong state vectors and a
+// flat checkpoint store of one vector per multiple of K, resized only when adaptation
+// changes K. Returns the log-likelihood. SCALED checkpoints hold normalised alphas
+// plus their cumulative log normaliser; LOG checkpoints hold log alphas.
+double forward_granularity_aware(const srf::DenseHmm& hmm, const std::vector<srf::Observation>& obs, int K_init, int G, srf::HmmArithmetic arith, srf::RegimeObserver& observer) {
     size_t T = obs.size();
-    size_t S = 2;
+    size_t S = hmm.states();
+    if (T == 0) return 0.0;
 
-    int current_K = K_init;
+    int current_K = std::max(1, K_init);
     srf::GranularityPolicy policy(srf::GranularityType::SEGMENT, G);
     srf::DriftDetector detector;
     srf::AdaptationPolicy adapter(100);
 
-    std::vector<std::vector<double>> checkpoints((T / 2) + 1, std::vector<double>(S)); // Bounded size
-    std::vector<double> alpha(S);
-    srf::global_metrics.update_working_set((checkpoints.size() * S + S) * sizeof(double));
+    // One vector per multiple of K in [0, T); resized below whenever adaptation changes K.
+    size_t rows = (T - 1) / current_K + 1;
+    size_t stored = 1;
+    std::vector<double> checkpoints(rows * S);
+    std::vector<double> checkpoint_log(arith == srf::HmmArithmetic::SCALED ? rows : 0);
+    std::vector<double> alpha(S), next_alpha(S), scratch(S);
+    srf::global_metrics.update_working_set((checkpoints.size() + checkpoint_log.size() + S) * sizeof(double));
 
-    for (size_t s = 0; s < S; ++s) {
-        alpha[s] = start_p[s] * emit_p[s][obs[0]];
-        srf::global_metrics.record_compute(1);
-        srf::global_metrics.record_mem_access();
+    double log_scale = 0.0;
+    double top = 0.0;
+    if (arith == srf::HmmArithmetic::LOG) {
+        top = hmm.log_start(obs[0], alpha.data());
+    } else {
+        double n = hmm.start(obs[0], alpha.data());
+        if (arith == srf::HmmArithmetic::SCALED) {
+            for (size_t s = 0; s < S; ++s) alpha[s] /= n;
+            log_scale = std::log(n);
+            checkpoint_log[0] = log_scale;
+        }
     }
-    checkpoints[0] = alpha;
+    srf::global_metrics.record_compute(static_cast<long long>(S));
+    srf::global_metrics.record_mem_access(static_cast<long long>(S));
+    std::copy(alpha.begin(), alpha.end(), checkpoints.begin());
 
     for (size_t t = 1; t < T; ++t) {
         bool is_checkpoint = (t % current_K == 0);
@@ -56,17 +63,25 @@ double forward_granularity_aware(const std::vector<Observation>& obs, int K_init
             srf::global_metrics.record_recompute(1);
             srf::global_metrics.record_unit_recompute(policy.get_unit_id(t));
         }
-        
-        std::vector<double> next_alpha(S);
-        for (size_t s = 0; s < S; ++s) {
-            std::vector<double> trans_row = {trans_p[0][s], trans_p[1][s]};
-            next_alpha[s] = backend->forward_step_compute(alpha, trans_row, emit_p[s][obs[t]]);
-            srf::global_metrics.record_compute(1);
-            srf::global_metrics.record_mem_access();
+
+        if (arith == srf::HmmArithmetic::LOG) {
+            top = hmm.log_forward(alpha.data(), top, obs[t], next_alpha.data(), scratch.data());
+        } else {
+            double n = hmm.forward(alpha.data(), obs[t], next_alpha.data());
+            if (arith == srf::HmmArithmetic::SCALED) {
+                for (size_t s = 0; s < S; ++s) next_alpha[s] /= n;
+                log_scale += std::log(n);
+            }
+        }
+        srf::global_metrics.record_compute(static_cast<long long>(S));
+        srf::global_metrics.record_mem_access(static_cast<long long>(S));
+        std::swap(alpha, next_alpha);
+        if (is_checkpoint && stored < rows) {
+            std::copy(alpha.begin(), alpha.end(), checkpoints.begin() + stored * S);
+            if (!checkpoint_log.empty()) checkpoint_log[stored] = log_scale;
+            ++stored;
         }
-        alpha = next_alpha;
-        if (is_checkpoint) checkpoints[t / current_K] = alpha;
-        
+
         if (t % 10 == 0) {
             observer.record_snapshot(srf::global_metrics.compute_events, 
                                      srf::global_metrics.recompute_events, 
@@ -79,6 +94,14 @@ double forward_granularity_aware(const std::vector<Observation>& obs, int K_init
                 int old_K = current_K;
                 current_K += signal.delta;
                 if (current_K < 2) current_K = 2;
+                // Multiples of the new K still ahead; only an adaptation step reallocates.
+                if (current_K != old_K) {
+                    rows = stored + (T - 1) / current_K - t / current_K;
+                    checkpoints.resize(rows * S);
+                    checkpoints.shrink_to_fit();
+                    if (!checkpoint_log.empty()) checkpoint_log.resize(rows);
+                    srf::global_metrics.update_working_set((checkpoints.size() + checkpoint_log.size() + S) * sizeof(double));
+                }
                 std::cout << "ADAPTATION_EVENT: true" << std::endl;
                 std::cout << "ADAPTATION_REASON: " << signal.reason << std::endl;
                 std::cout << "OLD_PARAM: " << old_K << std::endl;
@@ -87,17 +110,76 @@ double forward_granularity_aware(const std::vector<Observation>& obs, int K_init
         }
     }
 
+    if (arith == srf::HmmArithmetic::LOG) {
+        if (top == -HUGE_VAL) return top;
+        double sum = 0.0;
+        for (size_t s = 0; s < S; ++s) sum += std::exp(alpha[s] - top);
+        return top + std::log(sum);
+    }
     double total_prob = 0.0;
     for (size_t s = 0; s < S; ++s) total_prob += alpha[s];
-    return total_prob;
+    return log_scale + std::log(total_prob);
+}
+
+// Forward steps against the binomial minimum for the same number of stored vectors.
+void print_schedule(bool revolve, size_t slots, size_t T, long long steps, long long min_steps) {
+    double sweep = (T > 1) ? static_cast<double>(T - 1) : 1.0;
+    std::cout << "Schedule: " << (revolve ? "binomial" : "stride") << std::endl;
+    if (revolve) std::cout << "Schedule_Slots: " << slots << std::endl;
+    std::cout << "Forward_Steps: " << steps << std::endl;
+    std::cout << "Forward_Steps_Min: " << min_steps << std::endl;
+    std::cout << "Recompute_Factor: " << steps / sweep << std::endl;
+    std::cout << "Recompute_Factor_Min: " << min_steps / sweep << std::endl;
+}
+
+// Segment-parallel forward pass: work beyond one serial sweep.
+void print_scan(const srf::HmmScanReport& scan) {
+    std::cout << "Threads: " << scan.threads << std::endl;
+    std::cout << "Scan_Segments: " << scan.segments << std::endl;
+    std::cout << "Scan_Matrix_Steps: " << scan.matrix_steps << std::endl;
+    std::cout << "Scan_Matrix_Bytes: " << scan.matrix_bytes << std::endl;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 4) return 1;
-    std::vector<Observation> obs = load_observations(argv[1]);
-    int K = std::stoi(argv[2]);
-    int G = std::stoi(argv[3]);
-    std::string scale = (argc > 4) ? argv[4] : "NA";
+    // Usage: ./forward_checkpoint <seq_path> <segment_length> <group_size> [scale]
+    //                             [--model path] [--arith linear|scaled|log] [--threads N] [--posterior [--posterior-out path] [--revolve slots]]
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    if (args.positional.size() < 3) return 1;
+    // --model loads an S-state model file (see hmm_model.h) in place of the two-state weather model.
+    srf::HmmModel model = srf::HmmModel::weather();
+    std::string error;
+    if (args.has("model") && !model.load(args.get("model", ""), error)) {
+        std::cerr << "forward_checkpoint: " << error << std::endl;
+        return 1;
+    }
+    std::vector<srf::Observation> obs;
+    if (!srf::load_observations(args.positional[0], model, obs)) {
+        std::cerr << "forward_checkpoint: " << args.positional[0] << " has symbols outside the alphabet " << model.alphabet << std::endl;
+        return 1;
+    }
+    int K = std::stoi(args.positional[1]);
+    int G = std::stoi(args.positional[2]);
+    std::string scale = args.arg(3, "NA");
+    // --posterior runs forward-backward posterior decoding from checkpoints every K steps.
+    bool posterior = args.has("posterior");
+    // --revolve C replaces the fixed stride with a binomial schedule on exactly C stored vectors.
+    bool revolve = args.has("revolve");
+    size_t slots = static_cast<size_t>(std::max(1, args.get_int("revolve", 1)));
+    // --threads N runs the checkpointing forward pass segment-parallel in time (0: all hardware threads).
+    bool time_parallel = args.has("threads") && !revolve;
+    int threads = args.get_int("threads", 1);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    // --arith linear|scaled|log sets the plain sweep's arithmetic; the other modes always scale.
+    std::string arith_name = args.get("arith", "scaled");
+    srf::HmmArithmetic arith = srf::HmmArithmetic::SCALED;
+    if (arith_name == "linear") {
+        arith = srf::HmmArithmetic::LINEAR;
+    } else if (arith_name == "log") {
+        arith = srf::HmmArithmetic::LOG;
+    } else if (arith_name != "scaled") {
+        std::cerr << "forward_checkpoint: --arith must be linear, scaled or log" << std::endl;
+        return 1;
+    }
 
     auto backend = srf::BackendSelector::select(1024);
     srf::global_metrics.reset();
@@ -105,8 +187,50 @@ int main(int argc, char* argv[]) {
     
     srf::RegimeObserver observer;
 
+    srf::DenseHmm hmm(model);
+    srf::ThreadPool pool(time_parallel ? static_cast<size_t>(threads) : 1);
     auto start_time = std::chrono::high_resolution_clock::now();
-    double result = forward_granularity_aware(obs, K, G, backend.get(), observer);
+    double result = 0.0;
+    long long steps = static_cast<long long>(obs.size()) - 1;
+    srf::HmmPosteriorReport post;
+    srf::HmmScanReport scan;
+    double log_likelihood = 0.0;
+    std::vector<double> occupancy(model.states, 0.0);
+    if (posterior) {
+        // Fixed-width records, so rows produced last-segment-first can be written in place.
+        const size_t record = model.states * 12;
+        srf::DescendingRecordWriter out(args.get("posterior-out", ""), record);
+        std::vector<char> line(record + 1);
+        srf::HmmPosterior decoder(model, obs, K);
+        if (time_parallel) decoder.set_pool(&pool);
+        auto sink = [&](size_t t, const double* gamma) {
+            for (size_t s = 0; s < model.states; ++s) occupancy[s] += gamma[s];
+            if (!out.is_open()) return;
+            for (size_t s = 0; s < model.states; ++s) {
+                std::snprintf(&line[s * 12], 13, "%.9f%c", gamma[s], s + 1 < model.states ? ' ' : '\n');
+            }
+            out.put(t, line.data());
+        };
+        log_likelihood = revolve ? decoder.run_binomial(slots, sink, post) : decoder.run(sink, post);
+        result = std::exp(log_likelihood);
+        steps = post.forward_steps + static_cast<long long>(obs.size()) - 1;
+        scan = post.scan;
+        observer.record_snapshot(srf::global_metrics.compute_events,
+                                 srf::global_metrics.recompute_events,
+                                 srf::global_metrics.memory_access_proxy,
+                                 srf::global_metrics.working_set_bytes);
+    } else if (time_parallel) {
+        std::vector<double> checkpoints, last;
+        log_likelihood = srf::HmmTimeParallel(hmm, obs, srf::HmmSemiring::SUM_PRODUCT, pool).run(static_cast<size_t>(K), checkpoints, last, scan);
+        result = std::exp(log_likelihood);
+        observer.record_snapshot(srf::global_metrics.compute_events,
+                                 srf::global_metrics.recompute_events,
+                                 srf::global_metrics.memory_access_proxy,
+                                 srf::global_metrics.working_set_bytes);
+    } else {
+        log_likelihood = forward_granularity_aware(hmm, obs, K, G, arith, observer);
+        result = std::exp(log_likelihood);
+    }
     auto end_time = std::chrono::high_resolution_clock::now();
     
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
@@ -118,8 +242,29 @@ int main(int argc, char* argv[]) {
     std::cout << "Algorithm: Forward" << std::endl;
     std::cout << "Dataset_Scale: " << scale << std::endl;
     std::cout << "Backend: " << (backend->type() == srf::BackendType::GPU ? "gpu" : "cpu") << std::endl;
+    const bool plain = !posterior && !time_parallel;
+    std::cout << "Mode: " << (posterior ? "posterior" : (time_parallel ? "parallel" : "forward")) << std::endl;
     std::cout << "Result_Check: " << result << std::endl;
     std::cout << "Time_us: " << duration << std::endl;
+    // Each forward or backward step is one S x S matrix-vector product.
+    std::cout << "States: " << model.states << std::endl;
+    std::cout << "HMM_Kernel: " << srf::simd_isa_name(hmm.isa()) << std::endl;
+    std::cout << "Transitions_per_s: " << (duration > 0 ? steps * static_cast<double>(model.states * model.states) * 1e6 / duration : 0.0) << std::endl;
+    std::cout << "Arithmetic: " << srf::hmm_arithmetic_name(plain ? arith : srf::HmmArithmetic::SCALED) << std::endl;
+    std::cout << "Log_Likelihood: " << log_likelihood << std::endl;
+    if (time_parallel) print_scan(scan);
+    if (posterior) {
+        std::cout << "Posterior_Interval: " << post.interval << std::endl;
+        std::cout << "Posterior_Checkpoints: " << post.checkpoints << std::endl;
+        std::cout << "Posterior_Checkpoint_Bytes: " << post.checkpoint_bytes << std::endl;
+        std::cout << "Posterior_Segment_Bytes: " << post.segment_bytes << std::endl;
+        std::cout << "Posterior_Recompute_Steps: " << post.recompute_steps << std::endl;
+        print_schedule(revolve, post.slots, obs.size(), post.forward_steps, post.min_forward_steps);
+        std::cout << "Posterior_Occupancy:";
+        for (double o : occupancy) std::cout << " " << o;
+        std::cout << std::endl;
+    }
+    std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
     std::cout << "Drift_State: " << (d_state == srf::DriftState::STABLE ? "STABLE" : (d_state == srf::DriftState::DRIFT_CANDIDATE ? "DRIFT_CANDIDATE" : "INSUFFICIENT_DATA")) << std::endl;
     std::cout << "R_mem: " << latest.r_mem << std::endl;
     std::cout << "R_rec: " << latest.r_rec << std::endl;
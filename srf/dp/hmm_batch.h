@@ -0,0 +1,143 @@
+#ifndef SRF_DP_HMM_BATCH_H
+#define SRF_DP_HMM_BATCH_H
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include "../core/srf_utils.hpp"
+#include "../backends/backend_interface.h"
+#include "../runtime/thread_pool.h"
+#include "hmm_model.h"
+
+namespace srf {
+
+struct HmmBatchReport {
+    size_t sequences = 0;
+    size_t lanes = 0;
+    size_t groups = 0;              // Lane groups of up to `lanes` sequences
+    long long steps = 0;            // Observations scored
+    long long masked_steps = 0;     // Lane-steps spent on finished or empty lanes
+};
+
+// Forward log-likelihoods of many observation sequences under one model.
+//
+// Sequences are dealt into groups of `lanes`, longest first when sorted, so
+// each group holds sequences of similar length. A group advances all of its
+// sequences together through IBackend::forward_batch_step, one sequence per
+// lane; a lane whose sequence has ended is masked (emission 1, normaliser not
+// accumulated) until the group's longest one finishes. Groups are spread over
+// the pool, each worker stepping through its own backend. Alphas are
+// renormalised every step exactly as in HmmPosterior, so the vectorized CPU
+// kernel reproduces its log-likelihood bit for bit.
+class HmmBatchForward {
+public:
+    HmmBatchForward(const HmmModel& model, size_t lanes, bool sort = true)
+        : model_(model), lanes_(std::max<size_t>(1, lanes)), sort_(sort) {}
+
+    // log_likelihoods[k] scores seqs[k]; an empty sequence scores 0.
+    // backends holds one backend per pool worker.
+    void run(const std::vector<std::vector<Observation>>& seqs, ThreadPool& pool,
+             std::vector<std::unique_ptr<IBackend>>& backends, std::vector<double>& log_likelihoods,
+             HmmBatchReport& report) const {
+        report = HmmBatchReport();
+        report.sequences = seqs.size();
+        report.lanes = lanes_;
+        log_likelihoods.assign(seqs.size(), 0.0);
+
+        std::vector<size_t> order(seqs.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (sort_) {
+            std::stable_sort(order.begin(), order.end(),
+                             [&](size_t a, size_t b) { return seqs[a].size() > seqs[b].size(); });
+        }
+        const size_t groups = (seqs.size() + lanes_ - 1) / lanes_;
+        report.groups = groups;
+        for (size_t g = 0; g < groups; ++g) {
+            size_t longest = 0;
+            for (size_t l = 0; l < lanes_; ++l) {
+                const size_t k = g * lanes_ + l;
+                const size_t len = k < order.size() ? seqs[order[k]].size() : 0;
+                longest = std::max(longest, len);
+                report.steps += static_cast<long long>(len);
+            }
+            report.masked_steps += static_cast<long long>(longest * lanes_);
+        }
+        report.masked_steps -= report.steps;
+        global_metrics.update_working_set(pool.size() * 3 * model_.states * lanes_ * sizeof(double));
+
+        pool.parallel_for(groups, [&](size_t g, size_t worker) {
+            score_group(seqs, order, g, *backends[worker], log_likelihoods);
+        });
+    }
+
+private:
+    void score_group(const std::vector<std::vector<Observation>>& seqs, const std::vector<size_t>& order, size_t g,
+                     IBackend& backend, std::vector<double>& log_likelihoods) const {
+        const size_t S = model_.states;
+        const size_t L = lanes_;
+        std::vector<const std::vector<Observation>*> lane(L, nullptr);
+        size_t longest = 0;
+        for (size_t l = 0; l < L && g * L + l < order.size(); ++l) {
+            lane[l] = &seqs[order[g * L + l]];
+            longest = std::max(longest, lane[l]->size());
+        }
+        if (longest == 0) return;
+
+        std::vector<double> prev(S * L), out(S * L), emission(S * L), totals(L), log_sum(L, 0.0);
+        for (size_t l = 0; l < L; ++l) {
+            const bool active = lane[l] && !lane[l]->empty();
+            for (size_t s = 0; s < S; ++s) prev[s * L + l] = model_.start[s] * (active ? model_.b(s, (*lane[l])[0]) : 1.0);
+        }
+        normalise(prev, lane, 0, totals, log_sum);
+
+        for (size_t t = 1; t < longest; ++t) {
+            for (size_t s = 0; s < S; ++s) {
+                for (size_t l = 0; l < L; ++l) {
+                    emission[s * L + l] = (lane[l] && t < lane[l]->size()) ? model_.b(s, (*lane[l])[t]) : 1.0;
+                }
+            }
+            backend.forward_batch_step(prev, model_.trans, emission, S, out);
+            normalise(out, lane, t, totals, log_sum);
+            std::swap(prev, out);
+        }
+
+        long long scored = 0;
+        for (size_t l = 0; l < L; ++l) {
+            if (!lane[l]) continue;
+            log_likelihoods[order[g * L + l]] = log_sum[l];
+            scored += static_cast<long long>(lane[l]->size());
+        }
+        global_metrics.record_compute(scored * static_cast<long long>(S));
+        global_metrics.record_mem_access(static_cast<long long>(longest * S * L));
+    }
+
+    // Divides each lane by its state sum (summed in ascending state order) and
+    // adds the log of that sum for lanes still inside their sequence at step t.
+    void normalise(std::vector<double>& x, const std::vector<const std::vector<Observation>*>& lane, size_t t,
+                   std::vector<double>& totals, std::vector<double>& log_sum) const {
+        const size_t S = model_.states;
+        const size_t L = lanes_;
+        std::fill(totals.begin(), totals.end(), 0.0);
+        for (size_t s = 0; s < S; ++s) {
+            for (size_t l = 0; l < L; ++l) totals[l] += x[s * L + l];
+        }
+        for (size_t s = 0; s < S; ++s) {
+            for (size_t l = 0; l < L; ++l) {
+                if (totals[l] > 0.0) x[s * L + l] /= totals[l];
+            }
+        }
+        for (size_t l = 0; l < L; ++l) {
+            if (lane[l] && t < lane[l]->size()) log_sum[l] += std::log(totals[l]);
+        }
+    }
+
+    const HmmModel& model_;
+    size_t lanes_;
+    bool sort_;
+};
+
+} // namespace srf
+
+#endif
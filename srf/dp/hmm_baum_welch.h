@@ -0,0 +1,319 @@
+#ifndef SRF_DP_HMM_BAUM_WELCH_H
+#define SRF_DP_HMM_BAUM_WELCH_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "../runtime/thread_pool.h"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+
+namespace srf {
+
+// Expected counts of one E-step (or one work unit of it).
+struct HmmCounts {
+    std::vector<double> start;   // Posterior occupancy at t = 0
+    std::vector<double> trans;   // sum_t alpha_t(i) (B[:, o_t+1] .* beta_t+1)(j) / norm_t; times A(i, j) it is the expected i -> j count
+    std::vector<double> emit;    // Expected emissions, [s * symbols + o]
+    double log_likelihood = 0.0;
+
+    void reset(size_t states, size_t symbols) {
+        start.assign(states, 0.0);
+        trans.assign(states * states, 0.0);
+        emit.assign(states * symbols, 0.0);
+        log_likelihood = 0.0;
+    }
+
+    void add(const HmmCounts& other) {
+        for (size_t k = 0; k < start.size(); ++k) start[k] += other.start[k];
+        for (size_t k = 0; k < trans.size(); ++k) trans[k] += other.trans[k];
+        for (size_t k = 0; k < emit.size(); ++k) emit[k] += other.emit[k];
+        log_likelihood += other.log_likelihood;
+    }
+};
+
+struct HmmTrainReport {
+    size_t sequences = 0;
+    long long steps = 0;                  // Observations per E-step
+    size_t split_sequences = 0;           // Sequences whose segments run in parallel
+    size_t units = 0;                     // Work units per E-step (whole sequences plus segments)
+    long long recompute_steps = 0;        // Forward steps re-run per E-step
+    size_t unit_bytes = 0;                // Largest checkpoint + segment store of one sequence
+    std::vector<double> log_likelihoods;  // One per E-step, the last for the trained model
+};
+
+// Baum-Welch training on the checkpointed forward-backward sweep.
+//
+// Each sequence keeps alpha only every K steps (K = ceil(sqrt(T)) unless an
+// interval is given) and recomputes one segment of alphas at a time while
+// beta is carried backwards through it, as in HmmPosterior, so a sequence
+// needs O(sqrt(T)) state vectors. Expected transition counts are gathered as
+// the outer products alpha_t (x) (B[:, o_t+1] .* beta_t+1) / norm_t and scaled by
+// A once in the M-step.
+//
+// The E-step is split into work units: a whole sequence, or for sequences of
+// at least split_steps observations one K-step segment. A split sequence first
+// runs its forward checkpoint sweep and a backward sweep storing beta at the
+// same boundaries, concurrently, after which its segments are independent.
+// Units run on the pool in waves, each into its own counts, and are added to
+// the total in unit order. The units and that order depend only on the input,
+// so the trained model is bit-identical for any thread count.
+class HmmBaumWelch {
+public:
+    HmmBaumWelch(const std::vector<std::vector<Observation>>& seqs, long long interval, size_t split_steps)
+        : seqs_(seqs), interval_(std::max(0LL, interval)), split_steps_(std::max<size_t>(1, split_steps)) {}
+
+    // Runs up to `iterations` E/M rounds on model, stopping early once an
+    // E-step gains less than tolerance in log-likelihood, then scores the
+    // trained model. Returns its log-likelihood.
+    double train(HmmModel& model, size_t iterations, double tolerance, ThreadPool& pool, HmmTrainReport& report) const {
+        report = HmmTrainReport();
+        HmmCounts counts;
+        for (size_t it = 0; it < iterations; ++it) {
+            report.log_likelihoods.push_back(expect(model, pool, counts, report));
+            const size_t n = report.log_likelihoods.size();
+            if (n > 1 && report.log_likelihoods[n - 1] - report.log_likelihoods[n - 2] < tolerance) return report.log_likelihoods.back();
+            maximise(counts, model);
+        }
+        report.log_likelihoods.push_back(expect(model, pool, counts, report));
+        return report.log_likelihoods.back();
+    }
+
+    // E-step: the expected counts of all sequences under model. Returns the
+    // total log-likelihood.
+    double expect(const HmmModel& model, ThreadPool& pool, HmmCounts& total, HmmTrainReport& report) const {
+        const DenseHmm dense(model);
+        const size_t S = model.states;
+        const size_t M = model.symbols;
+        const size_t W = pool.size();
+        total.reset(S, M);
+        std::vector<HmmCounts> wave(W);
+        for (HmmCounts& c : wave) c.reset(S, M);
+        report.sequences = seqs_.size();
+        report.steps = 0;
+        report.split_sequences = 0;
+        report.units = 0;
+        report.recompute_steps = 0;
+
+        size_t k = 0;
+        while (k < seqs_.size()) {
+            if (seqs_[k].size() >= split_steps_) {
+                expect_split(dense, model, seqs_[k], pool, wave, total, report);
+                ++k;
+                continue;
+            }
+            // A wave of up to W consecutive unsplit sequences.
+            size_t count = 0;
+            while (count < W && k + count < seqs_.size() && seqs_[k + count].size() < split_steps_) ++count;
+            std::vector<long long> recomputed(count, 0);
+            std::vector<size_t> bytes(count, 0);
+            pool.parallel_for(count, [&](size_t u, size_t) {
+                wave[u].reset(S, M);
+                expect_sequence(dense, model, seqs_[k + u], wave[u], recomputed[u], bytes[u]);
+            });
+            for (size_t u = 0; u < count; ++u) {
+                total.add(wave[u]);
+                report.steps += static_cast<long long>(seqs_[k + u].size());
+                report.recompute_steps += recomputed[u];
+                report.unit_bytes = std::max(report.unit_bytes, bytes[u]);
+            }
+            report.units += count;
+            k += count;
+        }
+        return total.log_likelihood;
+    }
+
+    // M-step: start, transition and emission rows renormalised from counts
+    // gathered under model. A row with no expected mass is left unchanged.
+    static void maximise(const HmmCounts& counts, HmmModel& model) {
+        const size_t S = model.states;
+        const size_t M = model.symbols;
+        std::vector<double> row(std::max(S, M));
+        normalise_row(counts.start.data(), S, model.start.data(), row.data());
+        for (size_t i = 0; i < S; ++i) {
+            for (size_t j = 0; j < S; ++j) row[j] = model.a(i, j) * counts.trans[i * S + j];
+            normalise_row(row.data(), S, &model.trans[i * S], row.data());
+            normalise_row(&counts.emit[i * M], M, &model.emit[i * M], row.data());
+        }
+    }
+
+private:
+    size_t interval_for(size_t T) const {
+        if (interval_ > 0) return static_cast<size_t>(interval_);
+        size_t K = static_cast<size_t>(std::sqrt(static_cast<double>(T)));
+        while (K * K < T) ++K;
+        return std::max<size_t>(1, K);
+    }
+
+    // out = x / sum(x) when the sum is positive; tmp may alias x.
+    static void normalise_row(const double* x, size_t n, double* out, double* tmp) {
+        double sum = 0.0;
+        for (size_t k = 0; k < n; ++k) sum += x[k];
+        if (!(sum > 0.0)) return;
+        for (size_t k = 0; k < n; ++k) tmp[k] = x[k] / sum;
+        std::copy(tmp, tmp + n, out);
+    }
+
+    // alpha_0 = normalise(start .* B[:, obs[0]]); returns the scale factor.
+    static double forward_start(const DenseHmm& dense, Observation o, double* alpha) {
+        const size_t S = dense.states();
+        const double scale = dense.start(o, alpha);
+        for (size_t s = 0; s < S; ++s) alpha[s] /= scale;
+        global_metrics.record_compute(static_cast<long long>(S));
+        return scale;
+    }
+
+    static double forward_step(const DenseHmm& dense, const double* prev, Observation o, double* out) {
+        const size_t S = dense.states();
+        const double scale = dense.forward(prev, o, out);
+        for (size_t s = 0; s < S; ++s) out[s] /= scale;
+        global_metrics.record_compute(static_cast<long long>(S));
+        return scale;
+    }
+
+    // Scaled alphas at t = 0, K, 2K, ... into checkpoints; returns the log-likelihood.
+    static double forward_checkpoints(const DenseHmm& dense, const std::vector<Observation>& obs, size_t K,
+                                      std::vector<double>& checkpoints) {
+        const size_t S = dense.states();
+        std::vector<double> alpha(S), next(S);
+        double log_likelihood = std::log(forward_start(dense, obs[0], alpha.data()));
+        std::copy(alpha.begin(), alpha.end(), checkpoints.begin());
+        for (size_t t = 1; t < obs.size(); ++t) {
+            log_likelihood += std::log(forward_step(dense, alpha.data(), obs[t], next.data()));
+            std::swap(alpha, next);
+            if (t % K == 0) std::copy(alpha.begin(), alpha.end(), checkpoints.begin() + (t / K) * S);
+        }
+        global_metrics.record_mem_access(static_cast<long long>(checkpoints.size()));
+        return log_likelihood;
+    }
+
+    // Scaled betas at t = K, 2K, ... (boundary seg + 1 into row seg).
+    static void backward_checkpoints(const DenseHmm& dense, const std::vector<Observation>& obs, size_t K,
+                                     std::vector<double>& checkpoints) {
+        const size_t S = dense.states();
+        std::vector<double> beta(S, 1.0), next(S), scratch(S);
+        for (size_t t = obs.size() - 1; t > 0; --t) {
+            const double scale = dense.backward(beta.data(), obs[t], next.data(), scratch.data());
+            for (size_t s = 0; s < S; ++s) next[s] /= scale;
+            global_metrics.record_compute(static_cast<long long>(S));
+            std::swap(beta, next);
+            if ((t - 1) % K == 0 && t - 1 > 0) std::copy(beta.begin(), beta.end(), checkpoints.begin() + ((t - 1) / K - 1) * S);
+        }
+        global_metrics.record_mem_access(static_cast<long long>(checkpoints.size()));
+    }
+
+    // Adds the counts of positions t0 .. t1 - 1. alpha0 is the checkpoint at
+    // t0; beta holds beta_t1 on entry (ignored when t1 = T) and beta_t0 on
+    // return. segment holds (t1 - t0) x S doubles, next and scratch S each.
+    static void expect_segment(const DenseHmm& dense, const HmmModel& model, const std::vector<Observation>& obs,
+                               size_t t0, size_t t1, const double* alpha0, double* beta, double* next, double* scratch,
+                               double* segment, HmmCounts& counts) {
+        const size_t S = model.states;
+        const size_t M = model.symbols;
+        const size_t T = obs.size();
+        std::copy(alpha0, alpha0 + S, segment);
+        for (size_t t = t0 + 1; t < t1; ++t) forward_step(dense, &segment[(t - 1 - t0) * S], obs[t], &segment[(t - t0) * S]);
+        global_metrics.record_recompute(static_cast<long long>((t1 - t0 - 1) * S));
+
+        for (size_t t = t1; t-- > t0;) {
+            const double* alpha = &segment[(t - t0) * S];
+            if (t + 1 < T) {
+                const double scale = dense.backward(beta, obs[t + 1], next, scratch);
+                double norm = 0.0;
+                for (size_t i = 0; i < S; ++i) norm += alpha[i] * next[i];
+                for (size_t i = 0; i < S; ++i) {
+                    const double a = alpha[i] / norm;
+                    if (a == 0.0) continue;
+                    double* row = &counts.trans[i * S];
+                    for (size_t j = 0; j < S; ++j) row[j] += a * scratch[j];
+                }
+                for (size_t s = 0; s < S; ++s) beta[s] = next[s] / scale;
+                global_metrics.record_compute(static_cast<long long>(2 * S));
+            } else {
+                std::fill(beta, beta + S, 1.0);
+            }
+            double norm = 0.0;
+            for (size_t s = 0; s < S; ++s) norm += alpha[s] * beta[s];
+            for (size_t s = 0; s < S; ++s) {
+                const double gamma = alpha[s] * beta[s] / norm;
+                counts.emit[s * M + obs[t]] += gamma;
+                if (t == 0) counts.start[s] += gamma;
+            }
+            global_metrics.record_mem_access(static_cast<long long>(S));
+        }
+    }
+
+    // One sequence as one unit: forward checkpoints, then segments last to first.
+    void expect_sequence(const DenseHmm& dense, const HmmModel& model, const std::vector<Observation>& obs,
+                         HmmCounts& counts, long long& recomputed, size_t& bytes) const {
+        const size_t T = obs.size();
+        const size_t S = model.states;
+        if (T == 0) return;
+        const size_t K = interval_for(T);
+        const size_t segments = (T - 1) / K + 1;
+        std::vector<double> checkpoints(segments * S), segment(std::min(K, T) * S), beta(S, 1.0), next(S), scratch(S);
+        bytes = (checkpoints.size() + segment.size() + 3 * S) * sizeof(double);
+        global_metrics.update_working_set(bytes);
+
+        counts.log_likelihood = forward_checkpoints(dense, obs, K, checkpoints);
+        for (size_t seg = segments; seg-- > 0;) {
+            const size_t t0 = seg * K;
+            expect_segment(dense, model, obs, t0, std::min(T, t0 + K), &checkpoints[seg * S], beta.data(), next.data(),
+                           scratch.data(), segment.data(), counts);
+        }
+        recomputed = static_cast<long long>(T - segments);
+    }
+
+    // A long sequence: alpha and beta boundary sweeps side by side, then its
+    // segments in waves of pool.size(), added to total in segment order.
+    void expect_split(const DenseHmm& dense, const HmmModel& model, const std::vector<Observation>& obs, ThreadPool& pool,
+                      std::vector<HmmCounts>& wave, HmmCounts& total, HmmTrainReport& report) const {
+        const size_t T = obs.size();
+        const size_t S = model.states;
+        const size_t M = model.symbols;
+        const size_t W = wave.size();
+        const size_t K = interval_for(T);
+        const size_t segments = (T - 1) / K + 1;
+        std::vector<double> alphas(segments * S), betas(segments * S, 1.0);
+        double log_likelihood = 0.0;
+        pool.parallel_for(2, [&](size_t side, size_t) {
+            if (side == 0) {
+                log_likelihood = forward_checkpoints(dense, obs, K, alphas);
+            } else {
+                backward_checkpoints(dense, obs, K, betas);
+            }
+        });
+
+        std::vector<std::vector<double>> buffers(W, std::vector<double>((K + 3) * S));
+        const size_t bytes = (alphas.size() + betas.size() + W * buffers[0].size()) * sizeof(double);
+        global_metrics.update_working_set(bytes);
+        for (size_t first = 0; first < segments; first += W) {
+            const size_t count = std::min(W, segments - first);
+            pool.parallel_for(count, [&](size_t u, size_t worker) {
+                const size_t seg = first + u;
+                const size_t t0 = seg * K;
+                double* buf = buffers[worker].data();
+                std::copy(&betas[seg * S], &betas[seg * S] + S, buf);
+                wave[u].reset(S, M);
+                expect_segment(dense, model, obs, t0, std::min(T, t0 + K), &alphas[seg * S], buf, buf + S, buf + 2 * S,
+                               buf + 3 * S, wave[u]);
+            });
+            for (size_t u = 0; u < count; ++u) total.add(wave[u]);
+        }
+        total.log_likelihood += log_likelihood;
+        report.steps += static_cast<long long>(T);
+        report.split_sequences += 1;
+        report.units += segments;
+        report.recompute_steps += static_cast<long long>(T - segments);
+        report.unit_bytes = std::max(report.unit_bytes, bytes);
+    }
+
+    const std::vector<std::vector<Observation>>& seqs_;
+    long long interval_;
+    size_t split_steps_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef SRF_DP_HMM_DENSE_H
+#define SRF_DP_HMM_DENSE_H
+
+#include <algorithm>
+#include <cmath>
+#include "../core/aligned_allocator.hpp"
+#include "../backends/cpu/hmm_simd.h"
+#include "hmm_model.h"
+
+namespace srf {
+
+// How the plain forward and Viterbi sweeps represent state vectors.
+enum class HmmArithmetic {
+    LINEAR,  // Raw probabilities (underflow to 0 on long inputs)
+    SCALED,  // Renormalised every step, log normalisers accumulated
+    LOG      // Log probabilities: log-sum-exp (forward), max-plus (Viterbi)
+};
+
+inline const char* hmm_arithmetic_name(HmmArithmetic a) {
+    return a == HmmArithmetic::LINEAR ? "linear" : (a == HmmArithmetic::SCALED ? "scaled" : "log");
+}
+
+// An HmmModel laid out for the dense step kernels.
+//
+// The transition matrix is held twice, A (from x to) for the forward and
+// Viterbi recursions and its transpose AT for the backward one, so every step
+// is a row-streaming matrix-vector product. Emissions are stored per symbol,
+// making B[:, o] one contiguous row. Rows are padded to a multiple of 8 doubles
+// and cache-line aligned. Nothing is allocated per step: callers own the
+// state vectors and pass them in as ping-pong buffers. Log copies of the
+// tables (log 0 = -inf) back the log-space steps.
+class DenseHmm {
+public:
+    explicit DenseHmm(const HmmModel& model, SimdIsa isa = SimdIsa::AVX512)
+        : states_(model.states), stride_((model.states + 7) / 8 * 8), kernels_(hmm_kernels(isa)),
+          start_(stride_, 0.0), A_(states_ * stride_, 0.0), AT_(states_ * stride_, 0.0),
+          BT_(model.symbols * stride_, 0.0), log_start_(stride_, -HUGE_VAL), log_A_(states_ * stride_, -HUGE_VAL),
+          log_BT_(model.symbols * stride_, -HUGE_VAL) {
+        for (size_t i = 0; i < states_; ++i) {
+            start_[i] = model.start[i];
+            for (size_t j = 0; j < states_; ++j) {
+                A_[i * stride_ + j] = model.a(i, j);
+                AT_[j * stride_ + i] = model.a(i, j);
+            }
+            for (size_t o = 0; o < model.symbols; ++o) BT_[o * stride_ + i] = model.b(i, o);
+        }
+        for (size_t k = 0; k < start_.size(); ++k) log_start_[k] = std::log(start_[k]);
+        for (size_t k = 0; k < A_.size(); ++k) log_A_[k] = std::log(A_[k]);
+        for (size_t k = 0; k < BT_.size(); ++k) log_BT_[k] = std::log(BT_[k]);
+    }
+
+    size_t states() const { return states_; }
+    size_t stride() const { return stride_; }
+    SimdIsa isa() const { return kernels_.isa; }
+    const HmmKernels& kernels() const { return kernels_; }
+    size_t table_bytes() const {
+        return (start_.size() + A_.size() + AT_.size() + BT_.size() + log_start_.size() + log_A_.size() + log_BT_.size()) * sizeof(double);
+    }
+
+    // Transition probabilities into state `to`, indexed by from-state.
+    const double* into(size_t to) const { return &AT_[to * stride_]; }
+
+    // out = start .* B[:, o]; returns sum(out).
+    double start(size_t o, double* out) const {
+        const double* b = &BT_[o * stride_];
+        double total = 0.0;
+        for (size_t s = 0; s < states_; ++s) {
+            out[s] = start_[s] * b[s];
+            total += out[s];
+        }
+        return total;
+    }
+
+    // out = (prev * A) .* B[:, o]; returns sum(out).
+    double forward(const double* prev, size_t o, double* out) const {
+        kernels_.mat_vec(A_.data(), states_, stride_, prev, out);
+        const double* b = &BT_[o * stride_];
+        double total = 0.0;
+        for (size_t s = 0; s < states_; ++s) {
+            out[s] *= b[s];
+            total += out[s];
+        }
+        return total;
+    }
+
+    // out = A * (B[:, o] .* next), i.e. beta_{t-1} from beta_t with o = obs[t];
+    // scratch holds states() doubles and is left holding B[:, o] .* next.
+    // Returns sum(out).
+    double backward(const double* next, size_t o, double* out, double* scratch) const {
+        const double* b = &BT_[o * stride_];
+        for (size_t s = 0; s < states_; ++s) scratch[s] = b[s] * next[s];
+        kernels_.mat_vec(AT_.data(), states_, stride_, scratch, out);
+        double total = 0.0;
+        for (size_t s = 0; s < states_; ++s) total += out[s];
+        return total;
+    }
+
+    // out = (V * A, max-product) .* B[:, o]; bp[s] is the argmax predecessor of
+    // s, the lowest state on ties. Returns max(out).
+    double viterbi(const double* V, size_t o, double* out, int* bp) const {
+        kernels_.max_vec(A_.data(), states_, stride_, V, out, bp);
+        const double* b = &BT_[o * stride_];
+        double top = 0.0;
+        for (size_t s = 0; s < states_; ++s) {
+            out[s] *= b[s];
+            top = std::max(top, out[s]);
+        }
+        return top;
+    }
+
+    // out = log(start .* B[:, o]); returns max(out).
+    double log_start(size_t o, double* out) const {
+        const double* b = &log_BT_[o * stride_];
+        double top = -HUGE_VAL;
+        for (size_t s = 0; s < states_; ++s) {
+            out[s] = log_start_[s] + b[s];
+            top = std::max(top, out[s]);
+        }
+        return top;
+    }
+
+    // Log-space forward step: out[s] = logsumexp_i(prev[i] + log A[i][s]) + log B[s, o].
+    // The sum is taken as m + log(sum_i exp(prev[i] - m) A[i][s]) with m = max(prev):
+    // S vectorized exps, the linear mat_vec kernel for the S x S part, then S
+    // vectorized logs. prev_max is max(prev); scratch holds states() doubles.
+    // Returns max(out).
+    double log_forward(const double* prev, double prev_max, size_t o, double* out, double* scratch) const {
+        if (prev_max == -HUGE_VAL) {
+            std::fill(out, out + states_, -HUGE_VAL);
+            return -HUGE_VAL;
+        }
+        kernels_.exp_shift(prev, prev_max, states_, scratch);
+        kernels_.mat_vec(A_.data(), states_, stride_, scratch, out);
+        kernels_.log_add(out, &log_BT_[o * stride_], prev_max, states_, out);
+        double top = -HUGE_VAL;
+        for (size_t s = 0; s < states_; ++s) top = std::max(top, out[s]);
+        return top;
+    }
+
+    // Log-space Viterbi step (max-plus): out[s] = max_i(V[i] + log A[i][s]) + log B[s, o],
+    // bp as in viterbi(). Returns max(out).
+    double log_viterbi(const double* V, size_t o, double* out, int* bp) const {
+        kernels_.max_plus_vec(log_A_.data(), states_, stride_, V, out, bp);
+        const double* b = &log_BT_[o * stride_];
+        double top = -HUGE_VAL;
+        for (size_t s = 0; s < states_; ++s) {
+            out[s] += b[s];
+            top = std::max(top, out[s]);
+        }
+        return top;
+    }
+
+private:
+    size_t states_;
+    size_t stride_;
+    HmmKernels kernels_;
+    AlignedVector<double> start_;
+    AlignedVector<double> A_;
+    AlignedVector<double> AT_;
+    AlignedVector<double> BT_;
+    AlignedVector<double> log_start_;
+    AlignedVector<double> log_A_;
+    AlignedVector<double> log_BT_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef SRF_DP_HMM_MODEL_H
+#define SRF_DP_HMM_MODEL_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdint>
+#include "../core/sequence_parser.hpp"
+
+namespace srf {
+
+// Observation symbol index. The named values are the weather model's symbols
+// (A, C, G, anything else); models loaded from a file use 0 .. symbols - 1.
+enum Observation : uint8_t { Walk, Shop, Clean, OBS_UNKNOWN };
+
+// Discrete-emission HMM with row-major parameter tables.
+//
+// Model files are whitespace-separated keywords and numbers ('#' starts a comment):
+//   states S
+//   alphabet ACGT        one character per symbol; '*' matches any other character
+//   start p_0 ... p_{S-1}
+//   transitions          S rows of S values, row = from-state
+//   emissions            S rows of |alphabet| values
+class HmmModel {
+public:
+    size_t states = 0;
+    size_t symbols = 0;
+    std::string alphabet;
+    std::vector<double> start;   // start[s]
+    std::vector<double> trans;   // trans[from * states + to]
+    std::vector<double> emit;    // emit[s * symbols + o]
+
+    double a(size_t from, size_t to) const { return trans[from * states + to]; }
+    double b(size_t s, size_t o) const { return emit[s * symbols + o]; }
+
+    // Symbol index of c, or -1 when c is outside the alphabet (and there is no '*').
+    int encode(char c) const { return symbol_of_[static_cast<unsigned char>(c)]; }
+
+    // The two-state model hard-coded in the HMM baselines.
+    static HmmModel weather() {
+        HmmModel m;
+        m.states = 2;
+        m.alphabet = "ACG*";
+        m.symbols = 4;
+        m.start = {0.6, 0.4};
+        m.trans = {0.7, 0.3,
+                   0.4, 0.6};
+        m.emit = {0.1, 0.4, 0.4, 0.1,
+                  0.6, 0.2, 0.1, 0.1};
+        m.index_alphabet();
+        return m;
+    }
+
+    // Reads a model file; returns false (leaving error set) if it is malformed.
+    bool load(const std::string& path, std::string& error) {
+        std::ifstream f(path);
+        if (!f.is_open()) { error = "cannot open " + path; return false; }
+        std::string text, line;
+        while (std::getline(f, line)) text += line.substr(0, line.find('#')) + "\n";
+        std::istringstream in(text);
+
+        *this = HmmModel();
+        std::string key;
+        while (in >> key) {
+            if (key == "states") {
+                in >> states;
+            } else if (key == "alphabet") {
+                in >> alphabet;
+                symbols = alphabet.length();
+            } else if (key == "start") {
+                if (!read(in, states, start)) { error = "start needs " + std::to_string(states) + " values"; return false; }
+            } else if (key == "transitions") {
+                if (!read(in, states * states, trans)) { error = "transitions needs S x S values"; return false; }
+            } else if (key == "emissions") {
+                if (!read(in, states * symbols, emit)) { error = "emissions needs S x |alphabet| values"; return false; }
+            } else {
+                error = "unknown keyword '" + key + "'";
+                return false;
+            }
+        }
+        if (states == 0 || symbols == 0 || symbols > 256 || start.size() != states ||
+            trans.size() != states * states || emit.size() != states * symbols) {
+            error = "states, alphabet, start, transitions and emissions are all required";
+            return false;
+        }
+        index_alphabet();
+        return true;
+    }
+
+    // Writes the model in the format load() reads, at full double precision.
+    bool save(const std::string& path) const {
+        std::ofstream f(path);
+        if (!f.is_open()) return false;
+        f.precision(17);
+        f << "states " << states << "\nalphabet " << alphabet << "\nstart";
+        for (double p : start) f << ' ' << p;
+        f << "\ntransitions\n";
+        write_rows(f, trans, states);
+        f << "emissions\n";
+        write_rows(f, emit, symbols);
+        return static_cast<bool>(f);
+    }
+
+private:
+    static void write_rows(std::ostream& out, const std::vector<double>& table, size_t width) {
+        for (size_t k = 0; k < table.size(); ++k) out << table[k] << ((k + 1) % width == 0 ? '\n' : ' ');
+    }
+
+    static bool read(std::istream& in, size_t count, std::vector<double>& out) {
+        out.resize(count);
+        for (double& v : out) {
+            if (!(in >> v) || !(v >= 0.0) || std::isinf(v)) return false;
+        }
+        return true;
+    }
+
+    void index_alphabet() {
+        int wildcard = -1;
+        for (size_t o = 0; o < alphabet.length(); ++o) {
+            if (alphabet[o] == '*') wildcard = static_cast<int>(o);
+        }
+        for (int c = 0; c < 256; ++c) symbol_of_[c] = wildcard;
+        for (size_t o = 0; o < alphabet.length(); ++o) {
+            if (alphabet[o] != '*') symbol_of_[static_cast<unsigned char>(alphabet[o])] = static_cast<int>(o);
+        }
+    }
+
+    int symbol_of_[256] = {};
+};
+
+// Observations of path's sequence (the first token, or the first FASTA
+// record; see SequenceParser), encoded with model's alphabet. Returns false
+// if a character is outside the alphabet.
+inline bool load_observations(const std::string& path, const HmmModel& model, std::vector<Observation>& obs) {
+    std::ifstream f(path, std::ios::binary);
+    std::string s;
+    std::vector<char> buf(1 << 16);
+    SequenceParser parser;
+    while (f && !parser.finished()) {
+        f.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        parser.feed(buf.data(), static_cast<size_t>(f.gcount()), s);
+    }
+    obs.clear();
+    obs.reserve(s.length());
+    for (char c : s) {
+        int o = model.encode(c);
+        if (o < 0) return false;
+        obs.push_back(static_cast<Observation>(o));
+    }
+    return true;
+}
+
+} // namespace srf
+
+#endif
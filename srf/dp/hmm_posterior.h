@@ -0,0 +1,209 @@
+#ifndef SRF_DP_HMM_POSTERIOR_H
+#define SRF_DP_HMM_POSTERIOR_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+#include "hmm_time_parallel.h"
+#include "revolve_schedule.h"
+
+namespace srf {
+
+struct HmmPosteriorReport {
+    long long interval = 0;          // Steps between stored forward checkpoints
+    size_t checkpoints = 0;          // Checkpoint vectors held
+    size_t checkpoint_bytes = 0;
+    size_t segment_bytes = 0;        // Transient alpha buffer for one segment
+    long long recompute_steps = 0;   // Forward steps recomputed by the backward pass
+    size_t slots = 0;                // Binomial schedule store, in states (0: fixed stride)
+    long long forward_steps = 0;     // All forward steps, first pass included
+    long long min_forward_steps = 0; // Binomial minimum for the same number of stored vectors
+    double log_likelihood = 0.0;
+    HmmScanReport scan;              // Forward pass segment scan (threads == 0: serial)
+};
+
+// Posterior decoding (forward-backward) in O(T/K + K) state vectors.
+//
+// The forward pass keeps alpha only at t = 0, K, 2K, ... The backward pass then
+// walks the segments from last to first. Each segment's alphas are recomputed
+// from its checkpoint into a K-step buffer, and beta is carried down through it,
+// giving gamma_t(s) = alpha_t(s) beta_t(s) / sum. Every recomputed step is one
+// the forward pass already did once, so the cost is at most one extra forward
+// sweep. Both vectors are renormalised each step so long inputs do not
+// underflow; the forward scale factors sum to the log-likelihood. Steps run on
+// the DenseHmm kernels, so the sweeps allocate nothing per step.
+class HmmPosterior {
+public:
+    HmmPosterior(const HmmModel& model, const std::vector<Observation>& obs, long long interval)
+        : model_(model), dense_(model), obs_(obs), interval_(std::max(1LL, interval)), scratch_(model.states) {}
+
+    // Runs the checkpointing forward pass of run() time-parallel on pool.
+    void set_pool(ThreadPool* pool) { pool_ = pool; }
+
+    // Calls sink(t, gamma) for every position, segment by segment from the end
+    // (so t descends); gamma points to one posterior per state, summing to 1.
+    // Returns the log-likelihood.
+    template <typename Sink>
+    double run(Sink&& sink, HmmPosteriorReport& report) {
+        report = HmmPosteriorReport();
+        report.interval = interval_;
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        if (T == 0) return 0.0;
+
+        if (pool_) {
+            std::vector<double> last;
+            log_likelihood_ = HmmTimeParallel(dense_, obs_, HmmSemiring::SUM_PRODUCT, *pool_).run(static_cast<size_t>(interval_), checkpoints_, last, report.scan);
+        } else {
+            forward();
+        }
+        report.log_likelihood = log_likelihood_;
+        report.checkpoints = checkpoints_.size() / S;
+        report.checkpoint_bytes = checkpoints_.size() * sizeof(double);
+
+        const size_t K = static_cast<size_t>(interval_);
+        std::vector<double> segment(std::min(K, T) * S);
+        std::vector<double> beta(S, 1.0), next_beta(S), gamma(S);
+        report.segment_bytes = segment.size() * sizeof(double);
+        global_metrics.update_working_set(report.checkpoint_bytes + report.segment_bytes + 3 * S * sizeof(double));
+
+        for (size_t seg = report.checkpoints; seg-- > 0;) {
+            const size_t t0 = seg * K;
+            const size_t t1 = std::min(T, t0 + K);
+            std::copy(checkpoints_.begin() + seg * S, checkpoints_.begin() + (seg + 1) * S, segment.begin());
+            for (size_t t = t0 + 1; t < t1; ++t) {
+                forward_step(&segment[(t - 1 - t0) * S], t, &segment[(t - t0) * S]);
+            }
+            const long long recomputed = static_cast<long long>(t1 - t0 - 1);
+            report.recompute_steps += recomputed;
+            global_metrics.record_recompute(recomputed * static_cast<long long>(S));
+            global_metrics.record_mem_access(static_cast<long long>(S));
+
+            for (size_t t = t1; t-- > t0;) {
+                if (t + 1 < T) {
+                    backward_step(beta.data(), t + 1, next_beta.data());
+                    std::swap(beta, next_beta);
+                }
+                const double* alpha = &segment[(t - t0) * S];
+                double norm = 0.0;
+                for (size_t s = 0; s < S; ++s) {
+                    gamma[s] = alpha[s] * beta[s];
+                    norm += gamma[s];
+                }
+                for (size_t s = 0; s < S; ++s) gamma[s] /= norm;
+                global_metrics.record_mem_access(static_cast<long long>(S));
+                sink(t, gamma.data());
+            }
+        }
+        report.forward_steps = static_cast<long long>(T - 1) + report.recompute_steps;
+        report.min_forward_steps = RevolveSchedule::min_steps(static_cast<long long>(T), static_cast<long long>(report.checkpoints + std::min(K, T)));
+        return log_likelihood_;
+    }
+
+    // The same decoding on a store of exactly `slots` alpha vectors, checkpointed
+    // by the binomial schedule instead of every K steps.
+    template <typename Sink>
+    double run_binomial(size_t slots, Sink&& sink, HmmPosteriorReport& report) {
+        report = HmmPosteriorReport();
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        RevolveSweep sweep(T, S, slots);
+        std::vector<double> beta(S, 1.0), next_beta(S), gamma(S);
+        size_t frontier = 0;
+        log_likelihood_ = 0.0;
+
+        sweep.run([&](double* alpha) {
+            const double scale = dense_.start(obs_[0], alpha);
+            for (size_t s = 0; s < S; ++s) alpha[s] /= scale;
+            global_metrics.record_compute(static_cast<long long>(S));
+            log_likelihood_ = std::log(scale);
+        }, [&](size_t t, const double* prev, double* out) {
+            const double scale = forward_step(prev, t, out);
+            if (t > frontier) {
+                frontier = t;
+                log_likelihood_ += std::log(scale);
+            } else {
+                global_metrics.record_recompute(static_cast<long long>(S));
+            }
+        }, [&](size_t t, const double* alpha) {
+            if (t + 1 < T) {
+                backward_step(beta.data(), t + 1, next_beta.data());
+                std::swap(beta, next_beta);
+            }
+            double norm = 0.0;
+            for (size_t s = 0; s < S; ++s) {
+                gamma[s] = alpha[s] * beta[s];
+                norm += gamma[s];
+            }
+            for (size_t s = 0; s < S; ++s) gamma[s] /= norm;
+            global_metrics.record_mem_access(static_cast<long long>(S));
+            sink(t, gamma.data());
+        });
+
+        report.slots = sweep.slots();
+        report.checkpoints = sweep.slots();
+        report.checkpoint_bytes = sweep.store_bytes();
+        report.segment_bytes = sweep.work_bytes();
+        report.forward_steps = sweep.steps();
+        report.recompute_steps = T > 0 ? sweep.steps() - static_cast<long long>(T - 1) : 0;
+        report.min_forward_steps = sweep.min_steps();
+        report.log_likelihood = log_likelihood_;
+        return log_likelihood_;
+    }
+
+private:
+    // out = normalise(prev * A .* B[:, obs[t]]); returns the scale factor.
+    double forward_step(const double* prev, size_t t, double* out) const {
+        const size_t S = model_.states;
+        const double scale = dense_.forward(prev, obs_[t], out);
+        for (size_t s = 0; s < S; ++s) out[s] /= scale;
+        global_metrics.record_compute(static_cast<long long>(S));
+        return scale;
+    }
+
+    // out = normalise(A * (B[:, obs[t]] .* next)), i.e. beta_{t-1} from beta_t.
+    void backward_step(const double* next, size_t t, double* out) {
+        const size_t S = model_.states;
+        const double scale = dense_.backward(next, obs_[t], out, scratch_.data());
+        for (size_t i = 0; i < S; ++i) out[i] /= scale;
+        global_metrics.record_compute(static_cast<long long>(S));
+    }
+
+    void forward() {
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        const size_t K = static_cast<size_t>(interval_);
+        checkpoints_.assign(((T - 1) / K + 1) * S, 0.0);
+        std::vector<double> alpha(S), next(S);
+
+        const double scale = dense_.start(obs_[0], alpha.data());
+        for (size_t s = 0; s < S; ++s) alpha[s] /= scale;
+        global_metrics.record_compute(static_cast<long long>(S));
+        log_likelihood_ = std::log(scale);
+        std::copy(alpha.begin(), alpha.end(), checkpoints_.begin());
+
+        for (size_t t = 1; t < T; ++t) {
+            log_likelihood_ += std::log(forward_step(alpha.data(), t, next.data()));
+            std::swap(alpha, next);
+            if (t % K == 0) std::copy(alpha.begin(), alpha.end(), checkpoints_.begin() + (t / K) * S);
+        }
+        global_metrics.record_mem_access(static_cast<long long>(checkpoints_.size()));
+        global_metrics.update_working_set((checkpoints_.size() + 2 * S) * sizeof(double));
+    }
+
+    const HmmModel& model_;
+    DenseHmm dense_;
+    const std::vector<Observation>& obs_;
+    long long interval_;
+    std::vector<double> scratch_;
+    ThreadPool* pool_ = nullptr;
+    std::vector<double> checkpoints_;
+    double log_likelihood_ = 0.0;
+};
+
+} // namespace srf
+
+#endif
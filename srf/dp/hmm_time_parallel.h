@@ -0,0 +1,281 @@
+#ifndef SRF_DP_HMM_TIME_PARALLEL_H
+#define SRF_DP_HMM_TIME_PARALLEL_H
+
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "../core/aligned_allocator.hpp"
+#include "../runtime/thread_pool.h"
+#include "hmm_dense.h"
+
+namespace srf {
+
+enum class HmmSemiring {
+    SUM_PRODUCT,  // Forward: vectors normalised to sum 1
+    MAX_PRODUCT   // Viterbi: vectors normalised to a maximum of 1
+};
+
+struct HmmScanReport {
+    size_t threads = 0;
+    size_t segments = 0;            // Time segments (1: plain serial sweep)
+    long long matrix_steps = 0;     // Steps folded into segment transfer matrices
+    size_t matrix_bytes = 0;
+    size_t uncertain_segments = 0;  // Max-product segments with a decision inside the rounding bound
+    long long fallback_steps = 0;   // Steps re-run serially to settle those decisions
+};
+
+// Parallel-in-time forward sweep for the checkpointed HMM engines.
+//
+// A step is a semiring matrix application x_t = x_{t-1} M_t, with
+// M_t = A diag(B[:, obs[t]]), so a segment of steps is one S x S transfer
+// matrix. Time is cut into threads + 1 segments on checkpoint boundaries:
+//   1. in parallel, segment 0 runs the serial sweep while segments 1 .. n-2
+//      each compose their transfer matrix (S matrix-vector products per step);
+//   2. a serial scan pushes each boundary vector through the next matrix;
+//   3. in parallel, segments 1 .. n-1 re-run the serial sweep from their
+//      boundary vector, writing checkpoints every K steps.
+// Matrix rows are rescaled by exact powers of two and the scan works on
+// normalised vectors plus log normalisers, so nothing underflows. The
+// composition costs S times a serial step, so the mode pays off when
+// threads > S + 1.
+//
+// Sum-product boundaries differ from the serial sweep by reassociation only;
+// the log-likelihood agrees to about 1e-12 relative. Max-product values carry
+// the same rounding, but the decoded path must be exact: in segments that start
+// from a scanned boundary, every argmax (and the final one) must beat its
+// runner-up by more than the accumulated rounding bound. A segment where one
+// does not is re-run serially, together with the segments before it back to
+// the last exact boundary, so every decision is the serial one.
+class HmmTimeParallel {
+public:
+    HmmTimeParallel(const DenseHmm& hmm, const std::vector<Observation>& obs, HmmSemiring ring, ThreadPool& pool)
+        : hmm_(hmm), obs_(obs), ring_(ring), pool_(pool) {}
+
+    // Writes the normalised state vector at t = 0, K, 2K, ... into checkpoints
+    // (S values each) and the one at T - 1 into last. Returns the sum of the
+    // log normalisers: the log-likelihood, or the log Viterbi path probability.
+    double run(size_t K, std::vector<double>& checkpoints, std::vector<double>& last, HmmScanReport& report) {
+        report = HmmScanReport();
+        report.threads = pool_.size();
+        const size_t T = obs_.size();
+        const size_t S = hmm_.states();
+        K = std::max<size_t>(1, K);
+        checkpoints.assign(T > 0 ? ((T - 1) / K + 1) * S : 0, 0.0);
+        last.assign(S, 0.0);
+        if (T == 0) return 0.0;
+
+        const size_t steps = T - 1;
+        const size_t parts = pool_.size() > 1 ? pool_.size() + 1 : 1;
+        length_ = std::max<size_t>(1, (steps + parts - 1) / parts);
+        length_ = (length_ + K - 1) / K * K;
+        const size_t segments = std::max<size_t>(1, (steps + length_ - 1) / length_);
+        report.segments = segments;
+
+        stride_ = hmm_.stride();
+        matrices_.assign(segments * S * stride_, 0.0);
+        exponents_.assign(segments * S, 0);
+        starts_.assign(segments * S, 0.0);
+        ends_.assign(segments * S, 0.0);
+        start_log_.assign(segments, 0.0);
+        segment_log_.assign(segments, 0.0);
+        uncertain_.assign(segments, 0);
+        report.matrix_bytes = segments > 2 ? (segments - 2) * S * stride_ * sizeof(double) : 0;
+        global_metrics.update_working_set(checkpoints.size() * sizeof(double) + report.matrix_bytes + 2 * segments * S * sizeof(double));
+
+        double* v0 = &starts_[0];
+        hmm_.start(obs_[0], v0);
+        start_log_[0] = std::log(normalise(v0));
+        std::copy(v0, v0 + S, checkpoints.begin());
+        global_metrics.record_compute(static_cast<long long>(S));
+
+        pool_.parallel_for(segments > 1 ? segments - 1 : 1, [&](size_t k, size_t) {
+            if (k == 0) {
+                replay(0, K, checkpoints, false);
+            } else {
+                compose(k);
+            }
+        });
+        if (segments > 2) report.matrix_steps = static_cast<long long>((segments - 2) * length_);
+
+        for (size_t k = 1; k < segments; ++k) {
+            if (k == 1) {
+                std::copy(&ends_[0], &ends_[0] + S, &starts_[S]);
+                start_log_[1] = start_log_[0] + segment_log_[0];
+            } else {
+                scan(k);
+            }
+        }
+
+        pool_.parallel_for(segments - 1, [&](size_t j, size_t) {
+            replay(j + 1, K, checkpoints, ring_ == HmmSemiring::MAX_PRODUCT && j + 1 >= 2);
+        });
+
+        // Segments 0 and 1 start from exact serial vectors; repair from there.
+        size_t exact = std::min<size_t>(1, segments - 1);
+        for (size_t k = 2; k < segments; ++k) {
+            if (!uncertain_[k]) continue;
+            report.uncertain_segments++;
+            for (size_t j = exact + 1; j <= k; ++j) {
+                std::copy(&ends_[(j - 1) * S], &ends_[j * S], &starts_[j * S]);
+                start_log_[j] = start_log_[j - 1] + segment_log_[j - 1];
+                const long long redone = replay(j, K, checkpoints, false);
+                report.fallback_steps += redone;
+                global_metrics.record_recompute(redone * static_cast<long long>(S));
+            }
+            exact = k;
+        }
+
+        const size_t end = segments - 1;
+        std::copy(&ends_[end * S], &ends_[end * S] + S, last.begin());
+        return start_log_[end] + segment_log_[end];
+    }
+
+private:
+    // Divides v by its sum (sum-product) or maximum (max-product); returns the divisor.
+    double normalise(double* v) const {
+        const size_t S = hmm_.states();
+        double n = 0.0;
+        for (size_t s = 0; s < S; ++s) n = (ring_ == HmmSemiring::SUM_PRODUCT) ? n + v[s] : std::max(n, v[s]);
+        for (size_t s = 0; s < S; ++s) v[s] /= n;
+        return n;
+    }
+
+    // The serial engines' step: out = normalise(in M_t); returns the divisor.
+    double step(const double* in, size_t t, double* out, int* bp) const {
+        const size_t S = hmm_.states();
+        const double n = (ring_ == HmmSemiring::SUM_PRODUCT) ? hmm_.forward(in, obs_[t], out) : hmm_.viterbi(in, obs_[t], out, bp);
+        for (size_t s = 0; s < S; ++s) out[s] /= n;
+        return n;
+    }
+
+    // Relative rounding bound between two max-product sweeps of t steps that
+    // took different (but near-tied) paths: about 3 roundings per step each.
+    static double rounding_bound(size_t t) { return (6.0 * static_cast<double>(t) + 16.0) * (DBL_EPSILON / 2); }
+
+    // True if every argmax of the step from V (recorded in bp) clears its
+    // runner-up by more than twice the rounding bound.
+    bool certified(const double* V, const int* bp, size_t t) const {
+        const size_t S = hmm_.states();
+        const double keep = 1.0 - 2.0 * rounding_bound(t);
+        for (size_t s = 0; s < S; ++s) {
+            const double* into = hmm_.into(s);
+            const size_t arg = static_cast<size_t>(bp[s]);
+            const double best = V[arg] * into[arg];
+            if (best == 0.0) continue;  // Zero entries are exact in both sweeps.
+            for (size_t i = 0; i < S; ++i) {
+                if (i != arg && V[i] * into[i] >= best * keep) return false;
+            }
+        }
+        return true;
+    }
+
+    bool certified_final(const double* V, size_t t) const {
+        const size_t S = hmm_.states();
+        const size_t arg = static_cast<size_t>(std::max_element(V, V + S) - V);
+        const double keep = 1.0 - 2.0 * rounding_bound(t);
+        for (size_t i = 0; i < S; ++i) {
+            if (i != arg && V[i] >= V[arg] * keep) return false;
+        }
+        return true;
+    }
+
+    // Serial sweep of segment k from starts_[k]; writes its checkpoints, end
+    // vector and log normaliser sum. Returns the number of steps run.
+    long long replay(size_t k, size_t K, std::vector<double>& checkpoints, bool certify) {
+        const size_t S = hmm_.states();
+        const size_t T = obs_.size();
+        const size_t t0 = k * length_;
+        const size_t t1 = std::min(T - 1, t0 + length_);
+        std::vector<double> x(&starts_[k * S], &starts_[k * S] + S), next(S);
+        std::vector<int> bp(S);
+        double log_sum = 0.0;
+        bool uncertain = false;
+        for (size_t t = t0 + 1; t <= t1; ++t) {
+            log_sum += std::log(step(x.data(), t, next.data(), bp.data()));
+            if (certify && !uncertain && !certified(x.data(), bp.data(), t)) uncertain = true;
+            std::swap(x, next);
+            if (t % K == 0) std::copy(x.begin(), x.end(), checkpoints.begin() + (t / K) * S);
+        }
+        if (certify && !uncertain && t1 == T - 1 && !certified_final(x.data(), t1)) uncertain = true;
+        std::copy(x.begin(), x.end(), &ends_[k * S]);
+        segment_log_[k] = log_sum;
+        uncertain_[k] = uncertain ? 1 : 0;
+        const long long ran = static_cast<long long>(t1 - t0);
+        global_metrics.record_compute(ran * static_cast<long long>(S));
+        global_metrics.record_mem_access(static_cast<long long>((t1 / K - t0 / K) * S));
+        return ran;
+    }
+
+    // Transfer matrix of segment k: row i is e_i pushed through the segment's
+    // steps. Rows are rescaled by 2^-e (exact) when they leave [2^-256, 2^256].
+    void compose(size_t k) {
+        const size_t S = hmm_.states();
+        const size_t t0 = k * length_;
+        const size_t t1 = std::min(obs_.size() - 1, t0 + length_);
+        double* P = &matrices_[k * S * stride_];
+        long long* exps = &exponents_[k * S];
+        for (size_t i = 0; i < S; ++i) P[i * stride_ + i] = 1.0;
+        std::vector<double> row(S);
+        std::vector<int> bp(S);
+        for (size_t t = t0 + 1; t <= t1; ++t) {
+            for (size_t i = 0; i < S; ++i) {
+                double* Pi = P + i * stride_;
+                const double n = (ring_ == HmmSemiring::SUM_PRODUCT) ? hmm_.forward(Pi, obs_[t], row.data())
+                                                                     : hmm_.viterbi(Pi, obs_[t], row.data(), bp.data());
+                std::copy(row.begin(), row.end(), Pi);
+                if (n > 0.0 && (n < 0x1p-256 || n > 0x1p256)) {
+                    int e = 0;
+                    std::frexp(n, &e);
+                    for (size_t s = 0; s < S; ++s) Pi[s] = std::ldexp(Pi[s], -e);
+                    exps[i] += e;
+                }
+            }
+        }
+        global_metrics.record_compute(static_cast<long long>((t1 - t0) * S * S));
+    }
+
+    // starts_[k] = normalise(starts_[k - 1] P_{k-1}), folding the row
+    // exponents and the divisor into start_log_[k].
+    void scan(size_t k) {
+        const size_t S = hmm_.states();
+        const double* v = &starts_[(k - 1) * S];
+        const double* P = &matrices_[(k - 1) * S * stride_];
+        const long long* exps = &exponents_[(k - 1) * S];
+        long long top = 0;
+        bool any = false;
+        for (size_t i = 0; i < S; ++i) {
+            if (v[i] > 0.0 && (!any || exps[i] > top)) { top = exps[i]; any = true; }
+        }
+        std::vector<double> x(S);
+        std::vector<int> arg(S);
+        for (size_t i = 0; i < S; ++i) x[i] = std::ldexp(v[i], static_cast<int>(std::max(-2000LL, exps[i] - top)));
+        double* out = &starts_[k * S];
+        if (ring_ == HmmSemiring::SUM_PRODUCT) {
+            hmm_.kernels().mat_vec(P, S, stride_, x.data(), out);
+        } else {
+            hmm_.kernels().max_vec(P, S, stride_, x.data(), out, arg.data());
+        }
+        start_log_[k] = start_log_[k - 1] + static_cast<double>(top) * std::log(2.0) + std::log(normalise(out));
+        global_metrics.record_compute(static_cast<long long>(S * S));
+    }
+
+    const DenseHmm& hmm_;
+    const std::vector<Observation>& obs_;
+    HmmSemiring ring_;
+    ThreadPool& pool_;
+    size_t length_ = 1;      // Steps per segment, a multiple of K
+    size_t stride_ = 0;
+    AlignedVector<double> matrices_;
+    std::vector<long long> exponents_;
+    std::vector<double> starts_;
+    std::vector<double> ends_;
+    std::vector<double> start_log_;
+    std::vector<double> segment_log_;
+    std::vector<char> uncertain_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
+#include "../runtime/thread_pool.h"
+#include "../control/regime_observer.h"
+#include "hmm_model.h"
+#include "hmm_baum_welch.h"
+
+struct SequenceRecord {
+    std::string name;
+    std::string seq;
+};
+
+// Multi-record input: FASTA (">name" headers, wrapped lines) or one sequence per line.
+std::vector<SequenceRecord> load_records(const std::string& path) {
+    std::ifstream f(path);
+    std::vector<SequenceRecord> records;
+    std::string line;
+    bool fasta = false;
+    while (std::getline(f, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line[0] == '>') {
+            records.push_back({line.substr(1), ""});
+            fasta = true;
+        } else if (fasta) {
+            records.back().seq += line;
+        } else {
+            records.push_back({"seq" + std::to_string(records.size()), line});
+        }
+    }
+    return records;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./hmm_train <records> <iterations> [scale] [--model init] [--model-out path] [--threads N]
+    //                    [--interval K] [--split N] [--tolerance X]
+    // Fits the model's start, transition and emission tables to every record by Baum-Welch.
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    if (args.positional.size() < 2) return 1;
+    size_t iterations = static_cast<size_t>(std::max(0, std::stoi(args.positional[1])));
+    std::string scale = args.arg(2, "NA");
+    int threads = args.get_int("threads", 0);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    // --interval K fixes the checkpoint stride (default: ceil(sqrt(T)) per sequence).
+    long long interval = args.get_int("interval", 0);
+    // --split N runs sequences of N or more observations segment-parallel.
+    size_t split = static_cast<size_t>(std::max(1, args.get_int("split", 1 << 16)));
+    double tolerance = std::stod(args.get("tolerance", "0"));
+
+    srf::HmmModel model = srf::HmmModel::weather();
+    std::string error;
+    if (args.has("model") && !model.load(args.get("model", ""), error)) {
+        std::cerr << "hmm_train: " << error << std::endl;
+        return 1;
+    }
+    std::vector<SequenceRecord> records = load_records(args.positional[0]);
+    std::vector<std::vector<srf::Observation>> seqs(records.size());
+    for (size_t k = 0; k < records.size(); ++k) {
+        seqs[k].reserve(records[k].seq.length());
+        for (char c : records[k].seq) {
+            int o = model.encode(c);
+            if (o < 0) {
+                std::cerr << "hmm_train: record " << records[k].name << " has symbols outside the alphabet " << model.alphabet << std::endl;
+                return 1;
+            }
+            seqs[k].push_back(static_cast<srf::Observation>(o));
+        }
+    }
+
+    srf::global_metrics.reset();
+    srf::RegimeObserver observer;
+    srf::ThreadPool pool(static_cast<size_t>(threads));
+    srf::HmmBaumWelch trainer(seqs, interval, split);
+    srf::HmmTrainReport report;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double log_likelihood = trainer.train(model, iterations, tolerance, pool, report);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    observer.record_snapshot(srf::global_metrics.compute_events,
+                             srf::global_metrics.recompute_events,
+                             srf::global_metrics.memory_access_proxy,
+                             srf::global_metrics.working_set_bytes);
+    srf::RegimeSnapshot latest = observer.get_latest();
+
+    if (args.has("model-out") && !model.save(args.get("model-out", ""))) {
+        std::cerr << "hmm_train: cannot write " << args.get("model-out", "") << std::endl;
+        return 1;
+    }
+
+    for (size_t it = 0; it < report.log_likelihoods.size(); ++it) {
+        std::cout << "Iteration: " << it << " " << report.log_likelihoods[it] << std::endl;
+    }
+    const long long e_steps = static_cast<long long>(report.log_likelihoods.size());
+    std::cout << "Algorithm: Baum-Welch" << std::endl;
+    std::cout << "Dataset_Scale: " << scale << std::endl;
+    std::cout << "Threads: " << pool.size() << std::endl;
+    std::cout << "States: " << model.states << std::endl;
+    std::cout << "Sequences: " << report.sequences << std::endl;
+    std::cout << "Observations: " << report.steps << std::endl;
+    std::cout << "Iterations: " << e_steps - 1 << std::endl;
+    std::cout << "Split_Sequences: " << report.split_sequences << std::endl;
+    std::cout << "Work_Units: " << report.units << std::endl;
+    std::cout << "Recompute_Steps: " << report.recompute_steps << std::endl;
+    std::cout << "Unit_Bytes_Max: " << report.unit_bytes << std::endl;
+    std::cout << "Log_Likelihood: " << log_likelihood << std::endl;
+    std::cout << "Log_Likelihood_Gain: " << log_likelihood - report.log_likelihoods.front() << std::endl;
+    std::cout << "Time_us: " << duration << std::endl;
+    std::cout << "Transitions_per_s: " << (duration > 0 ? e_steps * report.steps * static_cast<double>(model.states * model.states) * 1e6 / duration : 0.0) << std::endl;
+    std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
+    std::cout << "R_mem: " << latest.r_mem << std::endl;
+    std::cout << "R_rec: " << latest.r_rec << std::endl;
+    std::cout << "Param_1: " << iterations << std::endl;
+
+    return 0;
+}
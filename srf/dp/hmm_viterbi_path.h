@@ -0,0 +1,200 @@
+#ifndef SRF_DP_HMM_VITERBI_PATH_H
+#define SRF_DP_HMM_VITERBI_PATH_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+#include "hmm_time_parallel.h"
+#include "revolve_schedule.h"
+
+namespace srf {
+
+struct HmmViterbiReport {
+    long long interval = 0;          // Steps between stored V checkpoints
+    size_t checkpoints = 0;          // Checkpoint vectors held
+    size_t checkpoint_bytes = 0;
+    size_t backpointer_bytes = 0;    // Transient backpointers for one segment
+    long long recompute_steps = 0;   // Steps re-run to regenerate backpointers
+    size_t slots = 0;                // Binomial schedule store, in states (0: fixed stride)
+    long long forward_steps = 0;     // All forward steps, first pass included
+    long long min_forward_steps = 0; // Binomial minimum for the same number of stored vectors
+    double log_probability = 0.0;    // log P(path, observations)
+    HmmScanReport scan;              // Forward pass segment scan (threads == 0: serial)
+};
+
+// Viterbi path recovery without a T x S backpointer table.
+//
+// The forward pass keeps V only at t = 0, K, 2K, ... The backtrace walks the
+// segments from last to first, re-running each segment from its checkpoint to
+// regenerate its K x S backpointers, and follows them down to the segment
+// start. Memory is O(T/K) checkpoints plus O(K * S) backpointers, for at most
+// one extra forward sweep. V is divided by its maximum every step (the log of
+// the divisors gives the path probability). Recomputation repeats the exact
+// same arithmetic, so every argmax, ties included (lowest state wins), matches
+// the first pass. Steps run on the DenseHmm max-product kernel.
+class HmmViterbiPath {
+public:
+    HmmViterbiPath(const HmmModel& model, const std::vector<Observation>& obs, long long interval)
+        : model_(model), dense_(model), obs_(obs), interval_(std::max(1LL, interval)) {}
+
+    // Runs the checkpointing forward pass of run() time-parallel on pool.
+    void set_pool(ThreadPool* pool) { pool_ = pool; }
+
+    // Calls sink(t, state) for every position, from t = T - 1 down to 0.
+    // Returns the log-probability of the path.
+    template <typename Sink>
+    double run(Sink&& sink, HmmViterbiReport& report) {
+        report = HmmViterbiReport();
+        report.interval = interval_;
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        if (T == 0) return 0.0;
+
+        std::vector<double> V(S), next(S);
+        const double log_probability = pool_ ? HmmTimeParallel(dense_, obs_, HmmSemiring::MAX_PRODUCT, *pool_).run(static_cast<size_t>(interval_), checkpoints_, V, report.scan)
+                                             : forward(V, next);
+        report.log_probability = log_probability;
+        report.checkpoints = checkpoints_.size() / S;
+        report.checkpoint_bytes = checkpoints_.size() * sizeof(double);
+
+        const size_t K = static_cast<size_t>(interval_);
+        std::vector<int> backpointers(std::max<size_t>(1, std::min(K, T - 1)) * S);
+        report.backpointer_bytes = backpointers.size() * sizeof(int);
+        global_metrics.update_working_set(report.checkpoint_bytes + report.backpointer_bytes + 2 * S * sizeof(double));
+
+        int state = static_cast<int>(std::max_element(V.begin(), V.end()) - V.begin());
+        for (size_t seg = report.checkpoints; seg-- > 0;) {
+            const size_t t0 = seg * K;
+            const size_t t1 = std::min(T, t0 + K);
+            // Backpointers of steps t0 + 1 .. t1 (step t1 links into the next segment).
+            const size_t steps = std::min(t1, T - 1) - t0;
+            std::copy(checkpoints_.begin() + seg * S, checkpoints_.begin() + (seg + 1) * S, V.begin());
+            for (size_t k = 0; k < steps; ++k) {
+                step(V.data(), t0 + 1 + k, next.data(), &backpointers[k * S]);
+                std::swap(V, next);
+            }
+            report.recompute_steps += static_cast<long long>(steps);
+            global_metrics.record_recompute(static_cast<long long>(steps * S));
+            global_metrics.record_mem_access(static_cast<long long>(S));
+
+            size_t t = t1;
+            if (t1 == T) sink(--t, state);
+            while (t > t0) {
+                state = backpointers[(t - t0 - 1) * S + state];
+                global_metrics.record_mem_access();
+                sink(--t, state);
+            }
+        }
+        report.forward_steps = static_cast<long long>(T - 1) + report.recompute_steps;
+        report.min_forward_steps = RevolveSchedule::min_steps(static_cast<long long>(T), static_cast<long long>(report.checkpoints + backpointers.size() / S));
+        return log_probability;
+    }
+
+    // The same path on a store of exactly `slots` V vectors, checkpointed by the
+    // binomial schedule. Visiting V_t in reverse, state_t is the argmax
+    // predecessor of state_{t+1}, the one backpointer the path needs.
+    template <typename Sink>
+    double run_binomial(size_t slots, Sink&& sink, HmmViterbiReport& report) {
+        report = HmmViterbiReport();
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        RevolveSweep sweep(T, S, slots);
+        std::vector<int> bp(S);
+        size_t frontier = 0;
+        double log_probability = 0.0;
+        int state = 0;
+
+        sweep.run([&](double* V) {
+            log_probability = std::log(init(V));
+        }, [&](size_t t, const double* V, double* next) {
+            const double top = step(V, t, next, bp.data());
+            if (t > frontier) {
+                frontier = t;
+                log_probability += std::log(top);
+            } else {
+                global_metrics.record_recompute(static_cast<long long>(S));
+            }
+        }, [&](size_t t, const double* V) {
+            if (t + 1 == T) {
+                state = static_cast<int>(std::max_element(V, V + S) - V);
+            } else {
+                const double* into = dense_.into(static_cast<size_t>(state));
+                double best = -1.0;
+                int arg = 0;
+                for (size_t i = 0; i < S; ++i) {
+                    const double p = V[i] * into[i];
+                    if (p > best) { best = p; arg = static_cast<int>(i); }
+                }
+                state = arg;
+            }
+            global_metrics.record_mem_access(static_cast<long long>(S));
+            sink(t, state);
+        });
+
+        report.slots = sweep.slots();
+        report.checkpoints = sweep.slots();
+        report.checkpoint_bytes = sweep.store_bytes();
+        report.backpointer_bytes = bp.size() * sizeof(int);
+        report.forward_steps = sweep.steps();
+        report.recompute_steps = T > 0 ? sweep.steps() - static_cast<long long>(T - 1) : 0;
+        report.min_forward_steps = sweep.min_steps();
+        report.log_probability = log_probability;
+        return log_probability;
+    }
+
+private:
+    // next = V * A (max-product) .* B[:, obs[t]], renormalised to a maximum of 1;
+    // bp[s] is the argmax predecessor of s. Returns the divisor.
+    double step(const double* V, size_t t, double* next, int* bp) const {
+        const size_t S = model_.states;
+        const double top = dense_.viterbi(V, obs_[t], next, bp);
+        for (size_t s = 0; s < S; ++s) next[s] /= top;
+        global_metrics.record_compute(static_cast<long long>(S));
+        return top;
+    }
+
+    // V = start .* B[:, obs[0]], renormalised to a maximum of 1; returns the divisor.
+    double init(double* V) const {
+        const size_t S = model_.states;
+        dense_.start(obs_[0], V);
+        const double top = *std::max_element(V, V + S);
+        for (size_t s = 0; s < S; ++s) V[s] /= top;
+        global_metrics.record_compute(static_cast<long long>(S));
+        return top;
+    }
+
+    // Leaves V at the last step; returns the log path probability.
+    double forward(std::vector<double>& V, std::vector<double>& next) {
+        const size_t T = obs_.size();
+        const size_t S = model_.states;
+        const size_t K = static_cast<size_t>(interval_);
+        checkpoints_.assign(((T - 1) / K + 1) * S, 0.0);
+        std::vector<int> bp(S);
+
+        double log_probability = std::log(init(V.data()));
+        std::copy(V.begin(), V.end(), checkpoints_.begin());
+
+        for (size_t t = 1; t < T; ++t) {
+            log_probability += std::log(step(V.data(), t, next.data(), bp.data()));
+            std::swap(V, next);
+            if (t % K == 0) std::copy(V.begin(), V.end(), checkpoints_.begin() + (t / K) * S);
+        }
+        global_metrics.record_mem_access(static_cast<long long>(checkpoints_.size()));
+        global_metrics.update_working_set((checkpoints_.size() + 2 * S) * sizeof(double) + S * sizeof(int));
+        return log_probability;
+    }
+
+    const HmmModel& model_;
+    DenseHmm dense_;
+    const std::vector<Observation>& obs_;
+    long long interval_;
+    ThreadPool* pool_ = nullptr;
+    std::vector<double> checkpoints_;
+};
+
+} // namespace srf
+
+#endif
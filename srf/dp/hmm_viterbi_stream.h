@@ -0,0 +1,237 @@
+#ifndef SRF_DP_HMM_VITERBI_STREAM_H
+#define SRF_DP_HMM_VITERBI_STREAM_H
+
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+
+namespace srf {
+
+// Power-of-two latency buckets: constant memory however many samples arrive.
+class LatencyHistogram {
+public:
+    void add(long long ns) {
+        size_t b = 0;
+        while (b + 1 < BUCKETS && (1LL << (b + 1)) <= ns) ++b;
+        ++counts_[b];
+        ++samples_;
+        total_ns_ += ns;
+        max_ns_ = std::max(max_ns_, ns);
+    }
+
+    long long samples() const { return samples_; }
+    double mean_us() const { return samples_ > 0 ? total_ns_ / 1e3 / samples_ : 0.0; }
+    double max_us() const { return max_ns_ / 1e3; }
+
+    // Upper edge of the bucket holding the p-quantile (within a factor of two).
+    double percentile_us(double p) const {
+        const long long rank = static_cast<long long>(std::ceil(p * samples_));
+        long long seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            seen += counts_[b];
+            if (seen >= rank && seen > 0) return std::min<long long>(1LL << (b + 1), max_ns_) / 1e3;
+        }
+        return 0.0;
+    }
+
+private:
+    static constexpr size_t BUCKETS = 48;
+    long long counts_[BUCKETS] = {};
+    long long samples_ = 0;
+    double total_ns_ = 0.0;
+    long long max_ns_ = 0;
+};
+
+struct HmmStreamReport {
+    long long max_lag = 0;            // Symbols a position may wait before it is committed
+    long long symbols = 0;            // Observations consumed
+    long long converged = 0;          // Positions committed at a convergence point
+    long long forced = 0;             // Positions committed at the lag limit
+    long long flushed = 0;            // Positions committed at the end of the stream
+    long long convergence_walks = 0;  // Survivor traces run
+    long long walk_steps = 0;         // Window steps those traces covered
+    long long lag_total = 0;          // Sum over positions of symbols received before commit
+    long long lag_max = 0;
+    size_t window_bytes = 0;          // Backpointer ring, arrival times and state vectors
+    double log_probability = 0.0;     // log P(committed path, observations)
+    LatencyHistogram latency;         // Arrival to commit, per position
+};
+
+// Viterbi decoding of an unbounded observation stream in constant memory.
+//
+// Observations are pushed one at a time. Backpointers live in a ring of
+// max_lag + 1 rows, one per uncommitted position. For every surviving state
+// (V > 0) the engine tracks its ancestor at the oldest uncommitted position,
+// which costs one gather per step; once all survivors share that ancestor,
+// the survivors are traced back to the newest position where they converge,
+// and everything up to it is committed. Such a prefix is part of every
+// continuation's best path, so without forced commits the output is exactly
+// the offline Viterbi path, ties included. A position still open after
+// max_lag further symbols is forced: the oldest half of the window is
+// committed along the current best path, and survivors that disagree with it
+// are dropped, so the output stays one consistent path (the best path through
+// the forced states). V is divided by its maximum every step, as in
+// HmmViterbiPath. sink(t, state) is called in increasing t.
+class HmmViterbiStream {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    HmmViterbiStream(const DenseHmm& dense, size_t max_lag)
+        : dense_(dense), states_(dense.states()), max_lag_(max_lag), window_(max_lag + 1),
+          V_(states_), next_(states_), bp_(window_ * states_), root_(states_), anc_(states_),
+          arrival_(window_), path_(window_) {}
+
+    template <typename Sink>
+    void push(Observation o, Sink&& sink) {
+        const size_t S = states_;
+        const size_t cur = t_;
+        arrival_[cur % window_] = Clock::now();
+        double top = 0.0;
+        if (cur == 0) {
+            dense_.start(o, V_.data());
+            top = *std::max_element(V_.begin(), V_.end());
+        } else {
+            top = dense_.viterbi(V_.data(), o, next_.data(), row(cur));
+            std::swap(V_, next_);
+        }
+        for (size_t s = 0; s < S; ++s) V_[s] /= top;
+        log_scale_ += std::log(top);
+        global_metrics.record_compute(static_cast<long long>(S));
+        ++t_;
+
+        if (committed_ == cur) {
+            for (size_t s = 0; s < S; ++s) root_[s] = static_cast<int>(s);
+        } else {
+            const int* bp = row(cur);
+            for (size_t s = 0; s < S; ++s) next_root(s) = root_[bp[s]];
+            for (size_t s = 0; s < S; ++s) root_[s] = next_root(s);
+        }
+        global_metrics.record_mem_access(static_cast<long long>(S));
+
+        if (agree(root_)) {
+            const size_t level = walk(committed_, true);
+            ++report_.convergence_walks;
+            report_.converged += static_cast<long long>(level - committed_ + 1);
+            commit(level, anc_[first_survivor()], sink);
+        }
+        if (t_ - committed_ > max_lag_) {
+            const size_t f = committed_ + max_lag_ / 2;
+            const size_t best = static_cast<size_t>(std::max_element(V_.begin(), V_.end()) - V_.begin());
+            walk(f, false);
+            const int state = anc_[best];
+            for (size_t s = 0; s < S; ++s) {
+                if (V_[s] > 0.0 && anc_[s] != state) V_[s] = 0.0;
+            }
+            report_.forced += static_cast<long long>(f - committed_ + 1);
+            commit(f, state, sink);
+        }
+    }
+
+    // Commits the rest of the window along the best final path.
+    // Returns the log-probability of the committed path.
+    template <typename Sink>
+    double finish(Sink&& sink, HmmStreamReport& report) {
+        if (committed_ < t_) {
+            const int best = static_cast<int>(std::max_element(V_.begin(), V_.end()) - V_.begin());
+            report_.flushed += static_cast<long long>(t_ - committed_);
+            commit(t_ - 1, best, sink);
+        }
+        report = report_;
+        report.max_lag = static_cast<long long>(max_lag_);
+        report.symbols = static_cast<long long>(t_);
+        report.window_bytes = (bp_.size() + root_.size() + anc_.size() + path_.size()) * sizeof(int) +
+                              arrival_.size() * sizeof(Clock::time_point) + (V_.size() + next_.size()) * sizeof(double);
+        report.log_probability = t_ > 0 ? log_scale_ : 0.0;
+        global_metrics.update_working_set(report.window_bytes + dense_.table_bytes());
+        return report.log_probability;
+    }
+
+private:
+    int* row(size_t t) { return &bp_[(t % window_) * states_]; }
+
+    // anc_ doubles as scratch while root_ is advanced.
+    int& next_root(size_t s) { return anc_[s]; }
+
+    size_t first_survivor() const {
+        size_t s = 0;
+        while (s + 1 < states_ && !(V_[s] > 0.0)) ++s;
+        return s;
+    }
+
+    // True when every surviving state maps to the same entry of x.
+    bool agree(const std::vector<int>& x) const {
+        const int first = x[first_survivor()];
+        for (size_t s = 0; s < states_; ++s) {
+            if (V_[s] > 0.0 && x[s] != first) return false;
+        }
+        return true;
+    }
+
+    // Steps anc_ from the newest position down towards `to`, stopping early
+    // once the survivors agree if until_agree. On return anc_ holds each
+    // survivor's ancestor at the returned position and root_ its ancestor one
+    // position later (when that is not the newest one).
+    size_t walk(size_t to, bool until_agree) {
+        const size_t S = states_;
+        size_t level = t_ - 1;
+        for (size_t s = 0; s < S; ++s) anc_[s] = static_cast<int>(s);
+        while (level > to && !(until_agree && agree(anc_))) {
+            const int* bp = row(level);
+            for (size_t s = 0; s < S; ++s) {
+                root_[s] = anc_[s];
+                anc_[s] = bp[anc_[s]];
+            }
+            --level;
+            ++report_.walk_steps;
+        }
+        global_metrics.record_mem_access(static_cast<long long>((t_ - 1 - level) * S));
+        return level;
+    }
+
+    // Emits positions committed_ .. last, following backpointers down from
+    // `state` at last.
+    template <typename Sink>
+    void commit(size_t last, int state, Sink&& sink) {
+        const size_t n = last - committed_ + 1;
+        path_[n - 1] = state;
+        for (size_t p = last; p > committed_; --p) {
+            state = row(p)[state];
+            path_[p - committed_ - 1] = state;
+        }
+        const Clock::time_point now = Clock::now();
+        const size_t newest = t_ - 1;
+        for (size_t k = 0; k < n; ++k) {
+            const size_t p = committed_ + k;
+            report_.latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(now - arrival_[p % window_]).count());
+            const long long lag = static_cast<long long>(newest - p);
+            report_.lag_total += lag;
+            report_.lag_max = std::max(report_.lag_max, lag);
+            sink(p, path_[k]);
+        }
+        committed_ = last + 1;
+    }
+
+    const DenseHmm& dense_;
+    size_t states_;
+    size_t max_lag_;
+    size_t window_;
+    std::vector<double> V_;
+    std::vector<double> next_;
+    std::vector<int> bp_;            // Row t % window_: argmax predecessors at position t
+    std::vector<int> root_;          // Ancestor at committed_ of each survivor at t_ - 1
+    std::vector<int> anc_;
+    std::vector<Clock::time_point> arrival_;
+    std::vector<int> path_;
+    size_t t_ = 0;                   // Positions pushed
+    size_t committed_ = 0;           // Positions emitted
+    double log_scale_ = 0.0;
+    HmmStreamReport report_;
+};
+
+} // namespace srf
+
+#endif
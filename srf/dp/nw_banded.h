@@ -0,0 +1,160 @@
+#ifndef SRF_DP_NW_BANDED_H
+#define SRF_DP_NW_BANDED_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "../backends/backend_interface.h"
+#include "../granularity/granularity_policy.h"
+#include "../control/regime_observer.h"
+
+namespace srf {
+
+struct NwBandReport {
+    long long band = 0;          // Final half-width around the diagonal strip
+    int attempts = 0;            // Band widths tried (1 = first band certified)
+    long long cells = 0;         // Cells evaluated over all attempts
+    bool certified = false;      // Score proven optimal by the band bound
+};
+
+// Number of x in [lo, hi] that are not multiples of B (tile-interior coordinates).
+inline long long count_tile_interior(long long lo, long long hi, long long B) {
+    if (hi < lo) return 0;
+    auto multiples_upto = [B](long long x) { return (x >= 0) ? x / B + 1 : 0; };
+    long long multiples = multiples_upto(hi) - multiples_upto(lo - 1);
+    return (hi - lo + 1) - multiples;
+}
+
+// Adaptive banded Needleman-Wunsch (Ukkonen-style band doubling).
+//
+// Only cells with j - i in [min(0, m-n) - w, max(0, m-n) + w] are evaluated.
+// Any path leaving that strip needs at least k_min gap steps, so it scores at
+// most best_step * (n + m - k_min) / 2 + gap * k_min. When the banded score
+// reaches that bound it is the global optimum; otherwise w is doubled and the
+// band is recomputed. Starting width is block_width, so one tile of slack.
+class NwBanded {
+public:
+    NwBanded(const std::string& s1, const std::string& s2, int match, int mismatch, int gap)
+        : s1_(s1), s2_(s2), match_(match), mismatch_(mismatch), gap_(gap) {}
+
+    int run(int B_init, int G, IBackend* backend, RegimeObserver& observer, NwBandReport& report) {
+        const long long n = s1_.length();
+        const long long m = s2_.length();
+        const long long B = (B_init > 0) ? B_init : 1;
+        GranularityPolicy policy(GranularityType::TILE, G);
+
+        long long w = B;
+        long long prev_lo = 0, prev_hi = -1;  // Strip evaluated by the previous attempt
+        int score = 0;
+        report = NwBandReport();
+        while (true) {
+            report.attempts++;
+            const long long lo = std::min(0LL, m - n) - w;
+            const long long hi = std::max(0LL, m - n) + w;
+            score = banded_pass(lo, hi, prev_lo, prev_hi, B, policy, backend, observer, report);
+
+            const bool full = (lo <= -n) && (hi >= m);
+            if (full || score >= out_of_band_bound(lo, hi)) {
+                report.certified = true;
+                break;
+            }
+            prev_lo = lo;
+            prev_hi = hi;
+            w *= 2;
+        }
+        report.band = w;
+        return score;
+    }
+
+private:
+    static constexpr int NEG = std::numeric_limits<int>::min() / 4;
+
+    // Highest score any path through a cell with j - i outside [lo, hi] can reach.
+    long long out_of_band_bound(long long lo, long long hi) const {
+        const long long n = s1_.length();
+        const long long m = s2_.length();
+        const long long delta = m - n;
+        auto gaps_via = [&](long long d) { return std::abs(d) + std::abs(delta - d); };
+        long long k_min = std::numeric_limits<long long>::max();
+        if (lo - 1 >= -n) k_min = std::min(k_min, gaps_via(lo - 1));
+        if (hi + 1 <= m) k_min = std::min(k_min, gaps_via(hi + 1));
+        const long long best_step = std::max({match_, mismatch_, 0});
+        // (n + m - k) / 2 diagonal steps; round up so the bound never undershoots.
+        return best_step * ((n + m - k_min + 1) / 2) + static_cast<long long>(gap_) * k_min;
+    }
+
+    int banded_pass(long long lo, long long hi, long long prev_lo, long long prev_hi, long long B,
+                    GranularityPolicy& policy, IBackend* backend, RegimeObserver& observer, NwBandReport& report) {
+        const long long n = s1_.length();
+        const long long m = s2_.length();
+        const long long width = hi - lo + 1;
+        std::vector<int> prev(width + 1, NEG), curr(width + 1, NEG);
+        global_metrics.update_working_set((prev.size() + curr.size()) * sizeof(int));
+
+        // Slot k of a row holds column j = i + lo + k.
+        for (long long j = 0; j <= std::min(m, hi); ++j) prev[j - lo] = static_cast<int>(j * gap_);
+        global_metrics.record_mem_access(std::min(m, hi) + 1);
+
+        for (long long i = 1; i <= n; ++i) {
+            std::fill(curr.begin(), curr.end(), NEG);
+            const long long j_lo = std::max(0LL, i + lo);
+            const long long j_hi = std::min(m, i + hi);
+            for (long long j = j_lo; j <= j_hi; ++j) {
+                const long long k = j - i - lo;
+                if (j == 0) {
+                    curr[k] = static_cast<int>(i * gap_);
+                    continue;
+                }
+                int match_score = (s1_[i - 1] == s2_[j - 1]) ? match_ : mismatch_;
+                int diag = prev[k];
+                int top = prev[k + 1];
+                int left = (k > 0) ? curr[k - 1] : NEG;
+                curr[k] = backend->nw_cell_compute(diag, top, left, match_score, gap_);
+            }
+            report.cells += record_row(i, j_lo, j_hi, prev_lo, prev_hi, B, policy);
+            std::swap(prev, curr);
+
+            if (i % B == 0 || i == n) {
+                observer.record_snapshot(global_metrics.compute_events,
+                                         global_metrics.recompute_events,
+                                         global_metrics.memory_access_proxy,
+                                         global_metrics.working_set_bytes);
+            }
+        }
+        return prev[m - n - lo];
+    }
+
+    // Tile-interior cells and cells already evaluated by a narrower band both count as recomputation.
+    long long record_row(long long i, long long j_lo, long long j_hi, long long prev_lo, long long prev_hi, long long B,
+                         GranularityPolicy& policy) {
+        const long long first = std::max(1LL, j_lo);
+        if (j_hi < first) return 0;
+        const long long cells = j_hi - first + 1;
+
+        const long long p_lo = std::max(first, i + prev_lo);
+        const long long p_hi = std::min(j_hi, i + prev_hi);
+        const long long seen = (prev_hi >= prev_lo && p_hi >= p_lo) ? p_hi - p_lo + 1 : 0;
+        long long interior = (i % B != 0) ? count_tile_interior(first, j_hi, B) : 0;
+        long long interior_seen = (i % B != 0 && seen > 0) ? count_tile_interior(p_lo, p_hi, B) : 0;
+        long long recompute = interior + seen - interior_seen;
+
+        global_metrics.record_compute(cells);
+        global_metrics.record_mem_access(2 * cells + 1);
+        global_metrics.record_recompute(recompute);
+        global_metrics.record_reuse(cells - recompute);
+        global_metrics.record_unit_recompute(policy.get_unit_id_2d(i, first));
+        return cells;
+    }
+
+    const std::string& s1_;
+    const std::string& s2_;
+    int match_;
+    int mismatch_;
+    int gap_;
+};
+
+} // namespace srf
+
+#endif
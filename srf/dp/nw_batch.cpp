@@ -0,0 +1,266 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
+#include "../runtime/backend_selector.h"
+#include "../runtime/thread_pool.h"
+#include "../runtime/work_stealing_pool.h"
+#include "../granularity/granularity_policy.h"
+#include "../control/regime_observer.h"
+
+struct Scoring {
+    int match = 1;
+    int mismatch = -1;
+    int gap = -1;
+};
+
+struct SequenceRecord {
+    std::string name;
+    std::string seq;
+};
+
+struct PairJob {
+    size_t a;
+    size_t b;
+};
+
+// Per-worker state: one backend and two reusable DP rows, so no allocation or
+// backend selection happens per pair.
+struct WorkerContext {
+    std::unique_ptr<srf::IBackend> backend;
+    std::vector<int> prev;
+    std::vector<int> curr;
+};
+
+std::string load_file(const std::string& path) {
+    std::ifstream f(path);
+    if (!f.is_open()) return "";
+    std::string s;
+    f >> s;
+    return s;
+}
+
+// Multi-record input: FASTA (">name" headers, wrapped lines) or one sequence per line.
+std::vector<SequenceRecord> load_records(const std::string& path) {
+    std::ifstream f(path);
+    std::vector<SequenceRecord> records;
+    std::string line;
+    bool fasta = false;
+    while (std::getline(f, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line[0] == '>') {
+            records.push_back({line.substr(1), ""});
+            fasta = true;
+        } else if (fasta) {
+            records.back().seq += line;
+        } else {
+            records.push_back({"seq" + std::to_string(records.size()), line});
+        }
+    }
+    return records;
+}
+
+void record_pair_metrics(const std::string& s1, const std::string& s2, int B) {
+    long long rows = static_cast<long long>(s1.length());
+    long long cols = static_cast<long long>(s2.length());
+    long long cells = rows * cols;
+    long long interior = (rows - rows / B) * (cols - cols / B);
+    srf::global_metrics.record_compute(cells);
+    srf::global_metrics.record_recompute(interior);
+    srf::global_metrics.record_mem_access(2 * cells + rows);
+    srf::global_metrics.record_reuse(cells - interior);
+}
+
+int nw_score_rows(const std::string& s1, const std::string& s2, int B, const Scoring& score, WorkerContext& ctx) {
+    record_pair_metrics(s1, s2, B);
+
+    int result = 0;
+    if (ctx.backend->nw_score_kernel(s1, s2, score.match, score.mismatch, score.gap, result)) return result;
+
+    size_t n = s1.length();
+    size_t m = s2.length();
+    if (ctx.prev.size() < m + 1) {
+        ctx.prev.resize(m + 1);
+        ctx.curr.resize(m + 1);
+    }
+    std::vector<int>& prev = ctx.prev;
+    std::vector<int>& curr = ctx.curr;
+    for (size_t j = 0; j <= m; ++j) prev[j] = static_cast<int>(j) * score.gap;
+    for (size_t i = 1; i <= n; ++i) {
+        curr[0] = static_cast<int>(i) * score.gap;
+        for (size_t j = 1; j <= m; ++j) {
+            int match_score = (s1[i - 1] == s2[j - 1]) ? score.match : score.mismatch;
+            curr[j] = ctx.backend->nw_cell_compute(prev[j - 1], prev[j], curr[j - 1], match_score, score.gap);
+        }
+        std::swap(prev, curr);
+    }
+    return prev[m];
+}
+
+long long percentile(const std::vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./nw_batch <manifest> <block_width> <group_size> [scale] [--threads N] [--intertask [--chunk N]]
+    //        ./nw_batch --all-vs-all <records> <block_width> <group_size> [scale] [--threads N]
+    // Manifest lines are "<seq_a_path> <seq_b_path>"; records are FASTA or one sequence per line.
+    // --intertask hands chunks of pairs to IBackend::nw_batch_compute (one pair per SIMD lane).
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    bool all_vs_all = args.has("all-vs-all");
+    std::vector<std::string> pos = args.positional;
+    if (all_vs_all) pos.insert(pos.begin(), args.get("all-vs-all", ""));
+    if (pos.size() < 3) return 1;
+    int B = std::stoi(pos[1]);
+    int G = std::stoi(pos[2]);
+    std::string scale = (pos.size() > 3 && !pos[3].empty()) ? pos[3] : "NA";
+    int threads = args.get_int("threads", 0);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    if (B < 1) B = 1;
+    bool intertask = args.has("intertask");
+    size_t chunk = static_cast<size_t>(std::max(1, args.get_int("chunk", 256)));
+
+    std::vector<SequenceRecord> records;
+    std::vector<PairJob> jobs;
+    if (all_vs_all) {
+        records = load_records(pos[0]);
+        for (size_t a = 0; a < records.size(); ++a)
+            for (size_t b = a + 1; b < records.size(); ++b) jobs.push_back({a, b});
+    } else {
+        // Each distinct path is read once, however many pairs reference it.
+        std::map<std::string, size_t> index;
+        auto intern = [&](const std::string& path) {
+            auto it = index.find(path);
+            if (it != index.end()) return it->second;
+            records.push_back({path, load_file(path)});
+            index[path] = records.size() - 1;
+            return records.size() - 1;
+        };
+        std::ifstream manifest(pos[0]);
+        std::string line;
+        while (std::getline(manifest, line)) {
+            std::istringstream ls(line);
+            std::string pa, pb;
+            if (!(ls >> pa >> pb) || pa[0] == '#') continue;
+            jobs.push_back({intern(pa), intern(pb)});
+        }
+    }
+
+    srf::global_metrics.reset();
+    srf::GranularityPolicy policy(srf::GranularityType::TILE, G);
+    srf::RegimeObserver observer;
+    Scoring score;
+
+    std::vector<WorkerContext> contexts(threads);
+    for (auto& ctx : contexts) ctx.backend = srf::BackendSelector::select(1024);
+
+    std::vector<long long> latencies(jobs.size());
+    std::mutex out_mutex;
+    size_t completed = 0;
+
+    long long steals = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        srf::WorkStealingPool pool(threads);
+        auto report = [&](size_t k, int result) {
+            // Results are streamed in completion order; caller holds out_mutex.
+            const PairJob& job = jobs[k];
+            std::cout << "Pair_Result: " << k << " " << records[job.a].name << " " << records[job.b].name
+                      << " " << result << " " << latencies[k] << std::endl;
+            srf::global_metrics.record_unit_recompute(policy.get_unit_id(static_cast<long long>(k)));
+            if (++completed % 64 == 0) {
+                observer.record_snapshot(srf::global_metrics.compute_events,
+                                         srf::global_metrics.recompute_events,
+                                         srf::global_metrics.memory_access_proxy,
+                                         srf::global_metrics.working_set_bytes);
+            }
+        };
+        // Inter-task mode: each task scores a chunk of pairs side by side, so a
+        // pair's latency is the latency of its whole chunk.
+        for (size_t c0 = 0; intertask && c0 < jobs.size(); c0 += chunk) {
+            pool.submit([&, c0](size_t worker) {
+                size_t c1 = std::min(jobs.size(), c0 + chunk);
+                std::vector<std::string> s1s, s2s;
+                std::vector<int> scores;
+                for (size_t k = c0; k < c1; ++k) {
+                    s1s.push_back(records[jobs[k].a].seq);
+                    s2s.push_back(records[jobs[k].b].seq);
+                }
+                auto t0 = std::chrono::high_resolution_clock::now();
+                contexts[worker].backend->nw_batch_compute(s1s, s2s, score.match, score.mismatch, score.gap, scores);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                long long us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+                std::lock_guard<std::mutex> lock(out_mutex);
+                for (size_t k = c0; k < c1; ++k) {
+                    latencies[k] = us;
+                    record_pair_metrics(s1s[k - c0], s2s[k - c0], B);
+                    report(k, scores[k - c0]);
+                }
+            });
+        }
+        for (size_t k = 0; !intertask && k < jobs.size(); ++k) {
+            pool.submit([&, k](size_t worker) {
+                const PairJob& job = jobs[k];
+                auto t0 = std::chrono::high_resolution_clock::now();
+                int result = nw_score_rows(records[job.a].seq, records[job.b].seq, B, score, contexts[worker]);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                latencies[k] = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+                std::lock_guard<std::mutex> lock(out_mutex);
+                report(k, result);
+            });
+        }
+        pool.wait_idle();
+        steals = pool.steal_count();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    size_t buffer_bytes = 0;
+    for (auto& ctx : contexts) {
+        buffer_bytes += (ctx.prev.capacity() + ctx.curr.capacity()) * sizeof(int);
+    }
+    srf::global_metrics.update_working_set(buffer_bytes);
+    observer.record_snapshot(srf::global_metrics.compute_events,
+                             srf::global_metrics.recompute_events,
+                             srf::global_metrics.memory_access_proxy,
+                             srf::global_metrics.working_set_bytes);
+    srf::RegimeSnapshot latest = observer.get_latest();
+
+    std::vector<long long> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    double pairs_per_s = (duration > 0) ? jobs.size() * 1e6 / duration : 0.0;
+
+    std::cout << "Algorithm: Needleman-Wunsch-Batch" << std::endl;
+    std::cout << "Dataset_Scale: " << scale << std::endl;
+    std::cout << "Backend: " << (contexts.front().backend->type() == srf::BackendType::GPU ? "gpu" : "cpu") << std::endl;
+    std::cout << "Kernel: " << contexts.front().backend->get_metrics().kernel << std::endl;
+    std::cout << "Mode: " << (intertask ? "intertask" : "pair") << std::endl;
+    std::cout << "Threads: " << threads << std::endl;
+    std::cout << "Pairs: " << jobs.size() << std::endl;
+    std::cout << "Steal_Count: " << steals << std::endl;
+    std::cout << "Time_us: " << duration << std::endl;
+    std::cout << "Pairs_per_s: " << pairs_per_s << std::endl;
+    std::cout << "Latency_p50_us: " << percentile(sorted, 0.50) << std::endl;
+    std::cout << "Latency_p95_us: " << percentile(sorted, 0.95) << std::endl;
+    std::cout << "Latency_p99_us: " << percentile(sorted, 0.99) << std::endl;
+    std::cout << "Latency_max_us: " << (sorted.empty() ? 0 : sorted.back()) << std::endl;
+    std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
+    std::cout << "R_mem: " << latest.r_mem << std::endl;
+    std::cout << "R_rec: " << latest.r_rec << std::endl;
+    std::cout << "Param_1: " << B << std::endl;
+    std::cout << "Param_3: " << G << std::endl;
+
+    return 0;
+}
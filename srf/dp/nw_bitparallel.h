@@ -0,0 +1,117 @@
+#ifndef SRF_DP_NW_BITPARALLEL_H
+#define SRF_DP_NW_BITPARALLEL_H
+
+#include <vector>
+#include <cstdint>
+#include "../core/srf_utils.hpp"
+#include "../core/packed_sequence.hpp"
+
+namespace srf {
+
+// Bit-parallel Needleman-Wunsch for unit-cost scoring (match = k, mismatch = gap = -k).
+//
+// This is Myers/Hyyro-style difference encoding, generalised to this scheme. The
+// NW score is not a function of the Levenshtein distance here, because
+// maximising the score minimises 4*mismatches + 3*gaps. Adjacent cells differ by
+// at most a small amount, though:
+//   dh_j = H[i][j] - H[i][j-1] and v_j = H[i][j] - H[i-1][j] both lie in {-1, 0, 1, 2}.
+// Row i is derived from row i-1 with
+//   t_j = max(s_ij - dh_j, -1),  v_j = max(t_j, v_{j-1} - (dh_j + 1)),  v_0 = -1,
+// where s_ij is +1 on a match and -1 otherwise.
+// The threshold sets {j : v_j >= 2}, {>= 1} and {>= 0} are 64-column bit
+// vectors. Runs through dh = -1 columns propagate with one carry-chain addition
+// per level, and the new dh' = v_j - v_{j-1} + dh_j is formed with bit-sliced
+// 2-bit arithmetic. dh + 1 is kept as two bit planes per row.
+// The final score is -n + sum(dh_j) at row n.
+class NwBitParallel {
+public:
+    static bool supports(int match, int mismatch, int gap) {
+        return match > 0 && mismatch == -match && gap == -match;
+    }
+
+    NwBitParallel(const PackedSequence& s2, int match)
+        : s2_(s2), unit_(match), words_((s2.length() + 63) / 64),
+          d0_(words_, 0), d1_(words_, 0), profile_(4 * words_) {
+        // Per-base match profile of s2 (Myers' Peq), built once from the packed words.
+        for (uint8_t c = 0; c < 4; ++c) {
+            PackedSequence::Query q;
+            q.code = c;
+            for (size_t w = 0; w < words_; ++w) profile_[c * words_ + w] = s2_.match_mask(64 * w, q);
+        }
+        global_metrics.update_working_set((d0_.size() + d1_.size() + profile_.size()) * sizeof(uint64_t));
+    }
+
+    // Scores all of s1; after_row(i) runs once row i (1-based) is complete.
+    template <typename RowHook>
+    int run(const PackedSequence& s1, RowHook&& after_row) {
+        for (size_t i = 0; i < s1.length(); ++i) {
+            advance(s1.query(i));
+            after_row(rows_);
+        }
+        return score();
+    }
+
+    // Computes the next row for one base of s1, so s1 can also be streamed.
+    void advance(const PackedSequence::Query& q) {
+        const uint64_t* peq = q.exception ? nullptr : &profile_[q.code * words_];
+        uint64_t in2 = 0, in1 = 0, in0 = 0;  // Level bits of the previous word's last column (v_0 = -1)
+        for (size_t w = 0; w < words_; ++w) {
+            const uint64_t eq = peq ? peq[w] : s2_.match_mask(64 * w, q);
+            const uint64_t D0 = d0_[w], D1 = d1_[w];
+            const uint64_t dm1 = ~D0 & ~D1, dz = D0 & ~D1, dp1 = ~D0 & D1, dp2 = D0 & D1;
+
+            // Level seeds: t_j >= theta, or v_{j-1} >= theta + c_j with c_j = dh_j + 1 >= 1.
+            const uint64_t V2 = propagate(eq & dm1, dm1, in2);
+            const uint64_t sh2 = (V2 << 1) | in2;
+            const uint64_t V1 = propagate((eq & (dm1 | dz)) | (dz & sh2), dm1, in1);
+            const uint64_t sh1 = (V1 << 1) | in1;
+            const uint64_t V0 = propagate(dm1 | (eq & ~dp2) | (dz & sh1) | (dp1 & sh2), dm1, in0);
+            const uint64_t sh0 = (V0 << 1) | in0;
+
+            // dh' + 1 = (v_j + 1) + (dh_j + 1) - (v_{j-1} + 1), bit-sliced over two planes.
+            const uint64_t a0 = (V0 & ~V1) | V2, a1 = V1;
+            const uint64_t b0 = (sh0 & ~sh1) | sh2, b1 = sh1;
+            const uint64_t s0 = a0 ^ D0, s1 = a1 ^ D1 ^ (a0 & D0);
+            d0_[w] = s0 ^ b0;
+            d1_[w] = s1 ^ b1 ^ (~s0 & b0);
+
+            in2 = V2 >> 63;
+            in1 = V1 >> 63;
+            in0 = V0 >> 63;
+        }
+        ++rows_;
+    }
+
+    long long rows() const { return rows_; }
+
+    // H[rows][m] for the rows advanced so far.
+    int score() const {
+        const long long m = s2_.length();
+        long long sum = 0;
+        for (size_t w = 0; w < words_; ++w) {
+            uint64_t valid = (w + 1 < words_ || m % 64 == 0) ? ~0ULL : (1ULL << (m % 64)) - 1;
+            sum += __builtin_popcountll(d0_[w] & valid) + 2LL * __builtin_popcountll(d1_[w] & valid);
+        }
+        return static_cast<int>((sum - m - rows_) * unit_);
+    }
+
+private:
+    // R_j = S_j | (P_j & R_{j-1}), with R_{-1} = in. Runs of P are filled by the carry of P + starts.
+    static uint64_t propagate(uint64_t S, uint64_t P, uint64_t in) {
+        const uint64_t Y = ((S << 1) | in) & P;
+        const uint64_t carries = (P + Y) ^ P ^ Y;
+        return S | Y | (carries & P);
+    }
+
+    const PackedSequence& s2_;
+    int unit_;
+    long long rows_ = 0;
+    size_t words_;
+    std::vector<uint64_t> d0_;
+    std::vector<uint64_t> d1_;
+    std::vector<uint64_t> profile_;
+};
+
+} // namespace srf
+
+#endif
@@ -4,11 +4,23 @@
 #include <fstream>
 #include <algorithm>
 #include <chrono>
+#include <memory>
 #include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
+#include "../core/packed_sequence.hpp"
+#include "../core/perf_counters.hpp"
 #include "../runtime/backend_selector.h"
+#include "../runtime/stream_prefetcher.h"
 #include "../granularity/granularity_policy.h"
 #include "../control/drift_detector.h"
 #include "../control/adaptation_policy.h"
+#include "nw_wavefront.h"
+#include "nw_traceback.h"
+#include "nw_checkpoint.h"
+#include "nw_banded.h"
+#include "nw_bitparallel.h"
+#include "nw_tiled.h"
+#include "nw_xdrop.h"
 
 struct Scoring {
     int match = 1;
@@ -16,24 +28,50 @@ struct Scoring {
     int gap = -1;
 };
 
-std::string load_file(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) return "";
-    std::string s;
-    f >> s;
-    return s;
-}
+// Per-row regime snapshot and drift-driven block-width adaptation, shared by the
+// row-sweep engines so both report the same adaptation events.
+class RowAdaptation {
+public:
+    RowAdaptation(int B_init, srf::RegimeObserver& observer)
+        : current_B_(B_init), observer_(observer), adapter_(50) {} // Cooldown
+
+    int block_width() const { return current_B_; }
+
+    void end_row() {
+        observer_.record_snapshot(srf::global_metrics.compute_events,
+                                  srf::global_metrics.recompute_events,
+                                  srf::global_metrics.memory_access_proxy,
+                                  srf::global_metrics.working_set_bytes);
+
+        // Evaluate Adaptation
+        srf::DriftState ds = detector_.detect(observer_);
+        srf::AdaptationSignal signal = adapter_.evaluate(ds, observer_);
+        if (signal.should_adapt) {
+            int old_B = current_B_;
+            current_B_ += signal.delta;
+            if (current_B_ < 2) current_B_ = 2; // Stability floor
+            std::cout << "ADAPTATION_EVENT: true" << std::endl;
+            std::cout << "ADAPTATION_REASON: " << signal.reason << std::endl;
+            std::cout << "OLD_PARAM: " << old_B << std::endl;
+            std::cout << "NEW_PARAM: " << current_B_ << std::endl;
+        }
+    }
 
-int nw_granularity_aware(const std::string& s1, const std::string& s2, int B_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
+private:
+    int current_B_;
+    srf::RegimeObserver& observer_;
+    srf::DriftDetector detector_;
+    srf::AdaptationPolicy adapter_;
+};
+
+int nw_granularity_aware(const srf::PackedSequence& s1, const srf::PackedSequence& s2, int B_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
     size_t n = s1.length();
     size_t m = s2.length();
     srf::GranularityPolicy policy(srf::GranularityType::TILE, G);
     std::vector<int> prev(m + 1), curr(m + 1);
     srf::global_metrics.update_working_set((prev.size() + curr.size()) * sizeof(int));
 
-    int current_B = B_init;
-    srf::DriftDetector detector;
-    srf::AdaptationPolicy adapter(50); // Cooldown
+    RowAdaptation adaptation(B_init, observer);
 
     for (size_t j = 0; j <= m; ++j) {
         prev[j] = j * -1;
@@ -43,13 +81,17 @@ int nw_granularity_aware(const std::string& s1, const std::string& s2, int B_ini
     for (size_t i = 1; i <= n; ++i) {
         curr[0] = i * -1;
         srf::global_metrics.record_mem_access();
+        // Match bits for 64 columns at a time; no per-cell base decoding.
+        const srf::PackedSequence::Query a = s1.query(i - 1);
+        uint64_t eq = 0;
         for (size_t j = 1; j <= m; ++j) {
-            int match_score = (s1[i - 1] == s2[j - 1]) ? 1 : -1;
+            if ((j - 1) % 64 == 0) eq = s2.match_mask(j - 1, a);
+            int match_score = ((eq >> ((j - 1) % 64)) & 1) ? 1 : -1;
             curr[j] = backend->nw_cell_compute(prev[j - 1], prev[j], curr[j - 1], match_score, -1);
             srf::global_metrics.record_compute(1);
             srf::global_metrics.record_mem_access();
             srf::global_metrics.record_mem_access();
-            if (i % current_B != 0 && j % current_B != 0) {
+            if (i % adaptation.block_width() != 0 && j % adaptation.block_width() != 0) {
                 srf::global_metrics.record_recompute(1);
                 srf::global_metrics.record_unit_recompute(policy.get_unit_id_2d(i, j));
             } else {
@@ -57,47 +99,208 @@ int nw_granularity_aware(const std::string& s1, const std::string& s2, int B_ini
             }
         }
         prev = curr;
-        
-        observer.record_snapshot(srf::global_metrics.compute_events, 
-                                 srf::global_metrics.recompute_events, 
-                                 srf::global_metrics.memory_access_proxy, 
-                                 srf::global_metrics.working_set_bytes);
-                                 
-        // Evaluate Adaptation
-        srf::DriftState ds = detector.detect(observer);
-        srf::AdaptationSignal signal = adapter.evaluate(ds, observer);
-        if (signal.should_adapt) {
-            int old_B = current_B;
-            current_B += signal.delta;
-            if (current_B < 2) current_B = 2; // Stability floor
-            std::cout << "ADAPTATION_EVENT: true" << std::endl;
-            std::cout << "ADAPTATION_REASON: " << signal.reason << std::endl;
-            std::cout << "OLD_PARAM: " << old_B << std::endl;
-            std::cout << "NEW_PARAM: " << current_B << std::endl;
-        }
+        adaptation.end_row();
     }
     return prev[m];
 }
 
+// The row sweep's per-cell accounting for row i, recorded in bulk.
+void record_row_bulk(long long i, long long m, long long B, srf::GranularityPolicy& policy) {
+    const long long recompute = (i % B != 0) ? m - m / B : 0;
+    srf::global_metrics.record_compute(m);
+    srf::global_metrics.record_mem_access(2 * m + 1);
+    srf::global_metrics.record_recompute(recompute);
+    srf::global_metrics.record_reuse(m - recompute);
+    if (recompute > 0) srf::global_metrics.record_unit_recompute(policy.get_unit_id_2d(i, 1));
+}
+
+// Bit-parallel engine for unit-cost scoring: 64 cells per word operation. The
+// per-cell accounting of the row sweep is recorded in bulk once per row.
+int nw_bit_parallel(const srf::PackedSequence& s1, const srf::PackedSequence& s2, int B_init, int G, srf::RegimeObserver& observer) {
+    Scoring score;
+    const long long m = s2.length();
+    srf::GranularityPolicy policy(srf::GranularityType::TILE, G);
+    RowAdaptation adaptation(B_init, observer);
+    srf::global_metrics.record_mem_access(m + 1);
+
+    srf::NwBitParallel engine(s2, score.match);
+    return engine.run(s1, [&](long long i) {
+        record_row_bulk(i, m, adaptation.block_width(), policy);
+        adaptation.end_row();
+    });
+}
+
+// Streaming query side: s1 is consumed chunk by chunk from the prefetcher and
+// never held in full, so memory is s2, the DP rows and two chunks. Each base is
+// one row of the bit-parallel engine, or of the per-cell sweep under --engine cell.
+int nw_streaming(srf::StreamPrefetcher& stream, const srf::PackedSequence& s2, bool bit_parallel, int B_init, int G,
+                 srf::IBackend* backend, srf::RegimeObserver& observer, long long& rows) {
+    Scoring score;
+    const long long m = s2.length();
+    srf::GranularityPolicy policy(srf::GranularityType::TILE, G);
+    RowAdaptation adaptation(B_init, observer);
+    srf::global_metrics.record_mem_access(m + 1);
+
+    std::unique_ptr<srf::NwBitParallel> engine;
+    std::vector<int> prev, curr;
+    if (bit_parallel) {
+        engine.reset(new srf::NwBitParallel(s2, score.match));
+    } else {
+        prev.resize(m + 1);
+        curr.resize(m + 1);
+        for (long long j = 0; j <= m; ++j) prev[j] = static_cast<int>(j) * score.gap;
+        srf::global_metrics.update_working_set((prev.size() + curr.size()) * sizeof(int));
+    }
+
+    rows = 0;
+    for (const std::vector<char>* chunk = &stream.next(); !chunk->empty(); chunk = &stream.next()) {
+        for (char c : *chunk) {
+            const srf::PackedSequence::Query a = srf::PackedSequence::query_for(c);
+            ++rows;
+            if (engine) {
+                engine->advance(a);
+            } else {
+                curr[0] = static_cast<int>(rows) * score.gap;
+                uint64_t eq = 0;
+                for (long long j = 1; j <= m; ++j) {
+                    if ((j - 1) % 64 == 0) eq = s2.match_mask(j - 1, a);
+                    int match_score = ((eq >> ((j - 1) % 64)) & 1) ? score.match : score.mismatch;
+                    curr[j] = backend->nw_cell_compute(prev[j - 1], prev[j], curr[j - 1], match_score, score.gap);
+                }
+                std::swap(prev, curr);
+            }
+            record_row_bulk(rows, m, adaptation.block_width(), policy);
+            adaptation.end_row();
+        }
+    }
+    return engine ? engine->score() : prev[m];
+}
+
+// Whole-matrix backend kernel (e.g. SRF_CPU_KERNEL=simd). The kernel only keeps
+// three anti-diagonals, so the tile accounting is derived analytically from B.
+bool nw_backend_kernel(const std::string& s1, const std::string& s2, int B, srf::IBackend* backend, srf::RegimeObserver& observer, int& result) {
+    Scoring score;
+    if (!backend->nw_score_kernel(s1, s2, score.match, score.mismatch, score.gap, result)) return false;
+
+    long long n = s1.length();
+    long long m = s2.length();
+    if (B < 1) B = 1;
+    long long cells = n * m;
+    long long interior = (n - n / B) * (m - m / B);
+    srf::global_metrics.update_working_set((3 * (n + 1) + n + m) * sizeof(int));
+    srf::global_metrics.record_compute(cells);
+    srf::global_metrics.record_recompute(interior);
+    srf::global_metrics.record_mem_access(2 * cells + n);
+    srf::global_metrics.record_reuse(cells - interior);
+    observer.record_snapshot(srf::global_metrics.compute_events,
+                             srf::global_metrics.recompute_events,
+                             srf::global_metrics.memory_access_proxy,
+                             srf::global_metrics.working_set_bytes);
+    return true;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 5) return 1;
-    std::string s1 = load_file(argv[1]);
-    std::string s2 = load_file(argv[2]);
-    int B = std::stoi(argv[3]);
-    int G = std::stoi(argv[4]);
-    std::string scale = (argc > 5) ? argv[5] : "NA";
+    // Usage: ./nw_blocked <seq_a> <seq_b> <block_width> <group_size> [scale]
+    //                    [--threads N] [--banded] [--xdrop X [--zdrop Z]] [--tiled [--cache-kb N]] [--engine auto|bitpar|cell]
+    //                    [--traceback] [--alignment-out path] [--stream [--chunk-kb N]]
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    if (args.positional.size() < 4) return 1;
+    // --stream (implied when seq_a is "-", i.e. stdin) reads s1 through the prefetcher instead of loading it.
+    bool streaming = args.has("stream") || args.positional[0] == "-";
+    if (streaming && args.has("traceback")) {
+        // A streamed s1 is never held in full, so there is nothing to trace back through.
+        std::cerr << "nw_blocked: --traceback needs seq_a loaded; it cannot be combined with --stream or stdin input" << std::endl;
+        return 1;
+    }
+    size_t chunk_bytes = static_cast<size_t>(std::max(1, args.get_int("chunk-kb", 1024))) * 1024;
+    // Sequences stay 2-bit packed; modes built on std::string unpack a copy on demand.
+    srf::PackedSequence s1 = streaming ? srf::PackedSequence() : srf::load_packed_sequence(args.positional[0]);
+    srf::PackedSequence s2 = srf::load_packed_sequence(args.positional[1]);
+    std::string s1_text, s2_text;
+    auto unpack = [&]() {
+        if (s1_text.length() != s1.length()) s1_text = s1.unpack();
+        if (s2_text.length() != s2.length()) s2_text = s2.unpack();
+    };
+    int B = std::stoi(args.positional[2]);
+    int G = std::stoi(args.positional[3]);
+    std::string scale = args.arg(4, "NA");
+    // --threads selects the tiled wavefront scheduler; without it the adaptive row sweep runs.
+    bool wavefront = args.has("threads");
+    int threads = args.get_int("threads", 1);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    std::string engine = args.get("engine", "auto");
+    if (engine != "auto" && engine != "bitpar" && engine != "cell") {
+        std::cerr << "nw_blocked: --engine must be auto, bitpar or cell" << std::endl;
+        return 1;
+    }
+    Scoring scoring;
+    if (engine == "bitpar" && !srf::NwBitParallel::supports(scoring.match, scoring.mismatch, scoring.gap)) {
+        std::cerr << "nw_blocked: --engine bitpar needs unit-cost scoring" << std::endl;
+        return 1;
+    }
+    // --tiled sizes cache-resident tiles from the L2 budget (or --cache-kb).
+    size_t cache_kb = static_cast<size_t>(args.get_int("cache-kb", static_cast<int>(srf::CacheModel::l2_budget_kb())));
+    int tile_side = srf::CacheModel(cache_kb, sizeof(int)).suggest_tile_size();
 
     auto backend = srf::BackendSelector::select(1024);
     srf::global_metrics.reset();
     backend->reset_metrics();
+    // The bit-parallel engine runs on the host and bypasses the backend, so auto only picks it on the
+    // CPU backend with unit-cost scoring; --engine bitpar forces it on any backend, ahead of the SIMD kernel.
+    bool bit_parallel = engine == "bitpar" ||
+                        (engine == "auto" && backend->type() == srf::BackendType::CPU &&
+                         srf::NwBitParallel::supports(scoring.match, scoring.mismatch, scoring.gap));
     
     srf::RegimeObserver observer;
 
+    srf::CacheCounters counters;
+    counters.start();
     auto start = std::chrono::high_resolution_clock::now();
-    int result = nw_granularity_aware(s1, s2, B, G, backend.get(), observer);
+    int result = 0;
+    std::string mode = "serial";
+    srf::NwBandReport band;
+    srf::NwXDropReport xdrop;
+    std::unique_ptr<srf::StreamPrefetcher> stream;
+    long long stream_rows = 0;
+    if (streaming) {
+        stream.reset(new srf::StreamPrefetcher(args.positional[0], chunk_bytes));
+        result = nw_streaming(*stream, s2, bit_parallel, B, G, backend.get(), observer, stream_rows);
+        mode = "stream";
+    } else if (args.has("banded")) {
+        Scoring score;
+        unpack();
+        srf::NwBanded banded(s1_text, s2_text, score.match, score.mismatch, score.gap);
+        result = banded.run(B, G, backend.get(), observer, band);
+        mode = "banded";
+    } else if (args.has("xdrop")) {
+        Scoring score;
+        unpack();
+        srf::NwXDrop extension(s1_text, s2_text, score.match, score.mismatch, score.gap);
+        result = extension.run(args.get_int("xdrop", 0), args.get_int("zdrop", 0), B, G, backend.get(), observer, xdrop);
+        mode = "xdrop";
+    } else if (wavefront) {
+        srf::ThreadPool pool(threads);
+        result = srf::nw_wavefront(s1, s2, B, G, pool, observer);
+        mode = "wavefront";
+    } else if (args.has("tiled")) {
+        result = srf::nw_tiled(s1, s2, tile_side, G, backend.get(), observer);
+        mode = "tiled";
+    } else if (backend->has_nw_score_kernel() && engine != "bitpar") {
+        unpack();
+        nw_backend_kernel(s1_text, s2_text, B, backend.get(), observer, result);
+        mode = "kernel";
+    } else if (bit_parallel) {
+        result = nw_bit_parallel(s1, s2, B, G, observer);
+        mode = "bitparallel";
+    } else {
+        result = nw_granularity_aware(s1, s2, B, G, backend.get(), observer);
+    }
     auto end = std::chrono::high_resolution_clock::now();
+    counters.stop();
     
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    double cells = static_cast<double>(streaming ? stream_rows : static_cast<long long>(s1.length())) * static_cast<double>(s2.length());
+    size_t forward_memory_kb = srf::get_peak_rss();
     
     srf::DriftDetector detector;
     srf::DriftState d_state = detector.detect(observer);
@@ -106,14 +309,102 @@ int main(int argc, char* argv[]) {
     std::cout << "Algorithm: Needleman-Wunsch" << std::endl;
     std::cout << "Dataset_Scale: " << scale << std::endl;
     std::cout << "Backend: " << (backend->type() == srf::BackendType::GPU ? "gpu" : "cpu") << std::endl;
+    std::cout << "Mode: " << mode << std::endl;
+    std::cout << "Kernel: " << backend->get_metrics().kernel << std::endl;
+    // --stream, --banded and --xdrop take precedence over --threads and run on one thread.
+    std::cout << "Threads: " << (mode == "wavefront" ? threads : 1) << std::endl;
     std::cout << "Result_Check: " << result << std::endl;
     std::cout << "Time_us: " << duration << std::endl;
-    std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
+    std::cout << "Cells_per_s: " << (duration > 0 ? static_cast<long long>(cells * 1e6 / duration) : 0) << std::endl;
+    if (mode == "banded") {
+        std::cout << "Band_Width: " << band.band << std::endl;
+        std::cout << "Band_Attempts: " << band.attempts << std::endl;
+        std::cout << "Band_Certified: " << (band.certified ? "true" : "false") << std::endl;
+        std::cout << "Cells_Evaluated: " << band.cells << std::endl;
+        std::cout << "Cells_Skipped: " << static_cast<long long>(cells) - band.cells << std::endl;
+    }
+    if (mode == "xdrop") {
+        std::cout << "XDrop_X: " << args.get_int("xdrop", 0) << std::endl;
+        std::cout << "ZDrop_Z: " << args.get_int("zdrop", 0) << std::endl;
+        std::cout << "Extension_End_i: " << xdrop.best_i << std::endl;
+        std::cout << "Extension_End_j: " << xdrop.best_j << std::endl;
+        std::cout << "Extension_Stop: " << xdrop.stop << std::endl;
+        std::cout << "Rows_Processed: " << xdrop.rows << std::endl;
+        std::cout << "Cells_Evaluated: " << xdrop.cells << std::endl;
+        std::cout << "Cells_Skipped: " << static_cast<long long>(cells) - xdrop.cells << std::endl;
+    }
+    if (mode == "stream") {
+        std::cout << "Stream_Rows: " << stream_rows << std::endl;
+        std::cout << "Stream_Chunk_Bytes: " << stream->chunk_bytes() << std::endl;
+        std::cout << "Stream_Bytes_Read: " << stream->bytes_read() << std::endl;
+        std::cout << "Stream_Wait_us: " << stream->wait_us() << std::endl;
+    }
+    if (mode == "tiled") {
+        std::cout << "Tile_Side: " << tile_side << std::endl;
+        std::cout << "Cache_Budget_kb: " << cache_kb << std::endl;
+    }
+    std::cout << "L1D_Misses: " << counters.str(srf::CacheCounters::L1D_MISSES) << std::endl;
+    std::cout << "L2_Misses: " << counters.str(srf::CacheCounters::L2_MISSES) << std::endl;
+    std::cout << "LLC_Misses: " << counters.str(srf::CacheCounters::LLC_MISSES) << std::endl;
+    std::cout << "Memory_kb: " << forward_memory_kb << std::endl;
+    std::cout << "Sequence_Bytes: " << s1.bytes() + s2.bytes() << std::endl;
     std::cout << "Drift_State: " << (d_state == srf::DriftState::STABLE ? "STABLE" : (d_state == srf::DriftState::DRIFT_CANDIDATE ? "DRIFT_CANDIDATE" : "INSUFFICIENT_DATA")) << std::endl;
     std::cout << "R_mem: " << latest.r_mem << std::endl;
     std::cout << "R_rec: " << latest.r_rec << std::endl;
     std::cout << "Param_1: " << B << std::endl;
     std::cout << "Param_3: " << G << std::endl;
 
+    // Traceback phase: recover the path in linear memory, leaves bounded by block_width^2 cells,
+    // or from delta-encoded checkpoint rows when --checkpoint-kb sets a budget.
+    if (args.has("traceback")) {
+        Scoring score;
+        long long recompute_before = srf::global_metrics.recompute_events;
+        srf::global_metrics.working_set_bytes = 0;
+        unpack();
+        bool checkpointed = args.has("checkpoint-kb");
+        srf::NwCheckpointReport cp;
+        srf::NwTraceback traceback(s1_text, s2_text, score.match, score.mismatch, score.gap, static_cast<long long>(B) * B);
+        auto tb_start = std::chrono::high_resolution_clock::now();
+        srf::NwAlignment alignment;
+        if (checkpointed) {
+            size_t budget = static_cast<size_t>(std::max(1, args.get_int("checkpoint-kb", 1024))) * 1024;
+            srf::NwCheckpointTraceback cp_traceback(s1_text, s2_text, score.match, score.mismatch, score.gap, budget);
+            alignment = cp_traceback.run(cp);
+        } else {
+            alignment = traceback.run();
+        }
+        auto tb_end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Traceback_Method: " << (checkpointed && !cp.hirschberg ? "checkpoint" : "hirschberg") << std::endl;
+        if (checkpointed) {
+            std::cout << "Checkpoint_Fallback: " << (cp.hirschberg ? "hirschberg" : "none") << std::endl;
+            std::cout << "Checkpoint_Interval: " << cp.interval << std::endl;
+            std::cout << "Checkpoint_Rows: " << cp.rows << std::endl;
+            std::cout << "Checkpoint_Bytes_per_Row: " << cp.bytes_per_row << std::endl;
+            std::cout << "Checkpoint_Raw_Bytes_per_Row: " << cp.raw_bytes_per_row << std::endl;
+            std::cout << "Checkpoint_Compression: " << (cp.bytes_per_row ? static_cast<double>(cp.raw_bytes_per_row) / cp.bytes_per_row : 0.0) << std::endl;
+            std::cout << "Checkpoint_Store_Bytes: " << cp.store_bytes << std::endl;
+            std::cout << "Checkpoint_Encode_Cells_per_s: " << static_cast<long long>(cp.encode_cells_per_s) << std::endl;
+            std::cout << "Checkpoint_Decode_Cells_per_s: " << static_cast<long long>(cp.decode_cells_per_s) << std::endl;
+        }
+        std::cout << "Alignment_CIGAR: " << alignment.cigar() << std::endl;
+        std::cout << "Alignment_Score: " << alignment.score << std::endl;
+        std::cout << "Traceback_Time_us: " << std::chrono::duration_cast<std::chrono::microseconds>(tb_end - tb_start).count() << std::endl;
+        // Estimated from the traceback's own buffers (score rows, leaf matrices, checkpoint store and
+        // block), not measured: peak RSS only grows, and the forward pass already set it (Memory_kb).
+        const size_t traceback_bytes = checkpointed ? cp.peak_bytes : traceback.peak_bytes();
+        std::cout << "Traceback_Memory_Est_kb: " << (traceback_bytes + 1023) / 1024 << std::endl;
+        std::cout << "Traceback_Working_Set_Proxy: " << srf::global_metrics.working_set_bytes << std::endl;
+        std::cout << "Traceback_Recompute_Events: " << (srf::global_metrics.recompute_events - recompute_before) << std::endl;
+
+        std::string out_path = args.get("alignment-out", "");
+        if (!out_path.empty()) {
+            std::string top, bottom;
+            traceback.gapped(alignment, top, bottom);
+            std::ofstream out(out_path);
+            out << top << "\n" << bottom << "\n";
+        }
+    }
+
     return 0;
 }
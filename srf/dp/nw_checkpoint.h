@@ -0,0 +1,289 @@
+#ifndef SRF_DP_NW_CHECKPOINT_H
+#define SRF_DP_NW_CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "../core/srf_utils.hpp"
+#include "nw_traceback.h"
+
+namespace srf {
+
+// Lossless delta encoding of one NW score row.
+//
+// With linear gaps, horizontally adjacent cells satisfy
+//   gap <= H[i][j] - H[i][j-1] <= max(match, mismatch) - gap,
+// so a row is stored as its first value plus (delta - gap) in `bits` bits per
+// cell. That is 2 bits for the unit-cost defaults, a 16x reduction over ints.
+// Fields never straddle a 64-bit word. When fields tile a byte exactly, decoding
+// reads a byte at a time through a prefix-sum table instead of field by field.
+class DeltaRowCodec {
+public:
+    DeltaRowCodec(int match, int mismatch, int gap) : lo_(gap) {
+        const long long range = static_cast<long long>(std::max(match, mismatch)) - 2LL * gap + 1;
+        bits_ = 1;
+        while ((1LL << bits_) < range) ++bits_;
+        per_word_ = 64 / bits_;
+        mask_ = (bits_ == 64) ? ~0ULL : (1ULL << bits_) - 1;
+        per_byte_ = (8 % bits_ == 0) ? 8 / bits_ : 0;
+        if (per_byte_ > 0) {
+            prefix_.assign(256 * per_byte_, 0);
+            for (int b = 0; b < 256; ++b) {
+                int sum = 0;
+                for (int f = 0; f < per_byte_; ++f) {
+                    sum += lo_ + static_cast<int>((b >> (f * bits_)) & mask_);
+                    prefix_[b * per_byte_ + f] = sum;
+                }
+            }
+        }
+    }
+
+    int bits() const { return bits_; }
+
+    size_t words_for(size_t len) const { return (len > 1) ? (len - 1 + per_word_ - 1) / per_word_ : 0; }
+
+    void encode(const int* row, size_t len, uint64_t* out) const {
+        for (size_t w = 0; w < words_for(len); ++w) {
+            const size_t j0 = 1 + w * per_word_;
+            const int count = static_cast<int>(std::min<size_t>(per_word_, len - j0));
+            uint64_t word = 0;
+            for (int f = 0; f < count; ++f) {
+                word |= static_cast<uint64_t>(row[j0 + f] - row[j0 + f - 1] - lo_) << (f * bits_);
+            }
+            out[w] = word;
+        }
+    }
+
+    void decode(int first, const uint64_t* in, size_t len, int* row) const {
+        if (len == 0) return;
+        int v = first;
+        row[0] = v;
+        for (size_t w = 0; w < words_for(len); ++w) {
+            uint64_t word = in[w];
+            size_t j = 1 + w * per_word_;
+            const size_t end = std::min(len, j + per_word_);
+            if (per_byte_ > 0) {
+                for (; j + per_byte_ <= end; j += per_byte_, word >>= 8) {
+                    const int* p = &prefix_[(word & 0xFF) * per_byte_];
+                    for (int f = 0; f < per_byte_; ++f) row[j + f] = v + p[f];
+                    v += p[per_byte_ - 1];
+                }
+            }
+            for (; j < end; ++j, word >>= bits_) {
+                v += lo_ + static_cast<int>(word & mask_);
+                row[j] = v;
+            }
+        }
+    }
+
+private:
+    int lo_;
+    int bits_;
+    int per_word_;
+    int per_byte_;
+    uint64_t mask_;
+    std::vector<int> prefix_;
+};
+
+// Fixed-length rows kept delta-encoded in one contiguous buffer, with
+// encode/decode timing for throughput reporting.
+class DeltaCheckpointStore {
+public:
+    DeltaCheckpointStore(const DeltaRowCodec& codec, size_t row_len)
+        : codec_(codec), row_len_(row_len), stride_(codec.words_for(row_len)) {}
+
+    // Encoded bytes for one row (first value + packed deltas).
+    static size_t row_bytes(const DeltaRowCodec& codec, size_t row_len) {
+        return sizeof(int) + codec.words_for(row_len) * sizeof(uint64_t);
+    }
+
+    size_t push(const int* row) {
+        auto t0 = std::chrono::steady_clock::now();
+        firsts_.push_back(row_len_ ? row[0] : 0);
+        words_.resize(words_.size() + stride_);
+        codec_.encode(row, row_len_, words_.data() + words_.size() - stride_);
+        encode_ns_ += elapsed_ns(t0);
+        encoded_cells_ += row_len_;
+        return firsts_.size() - 1;
+    }
+
+    // Decodes the first len cells of row k (len <= row length).
+    void load(size_t k, int* row, size_t len) const {
+        auto t0 = std::chrono::steady_clock::now();
+        codec_.decode(firsts_[k], words_.data() + k * stride_, len, row);
+        decode_ns_ += elapsed_ns(t0);
+        decoded_cells_ += len;
+    }
+
+    size_t rows() const { return firsts_.size(); }
+    size_t bytes() const { return firsts_.size() * sizeof(int) + words_.size() * sizeof(uint64_t); }
+    double encode_cells_per_s() const { return encode_ns_ > 0 ? encoded_cells_ * 1e9 / encode_ns_ : 0.0; }
+    double decode_cells_per_s() const { return decode_ns_ > 0 ? decoded_cells_ * 1e9 / decode_ns_ : 0.0; }
+
+private:
+    static long long elapsed_ns(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    const DeltaRowCodec& codec_;
+    size_t row_len_;
+    size_t stride_;
+    std::vector<int> firsts_;
+    std::vector<uint64_t> words_;
+    long long encode_ns_ = 0;
+    long long encoded_cells_ = 0;
+    mutable long long decode_ns_ = 0;
+    mutable long long decoded_cells_ = 0;
+};
+
+struct NwCheckpointReport {
+    long long interval = 0;      // Rows between stored checkpoints
+    size_t rows = 0;             // Checkpoint rows held
+    size_t bytes_per_row = 0;    // Encoded bytes per checkpoint row
+    size_t raw_bytes_per_row = 0;
+    size_t store_bytes = 0;
+    size_t peak_bytes = 0;       // Store plus the largest transient buffer (forward row or block)
+    bool hirschberg = false;     // The budget fit no checkpoint split; Hirschberg ran instead
+    double encode_cells_per_s = 0.0;
+    double decode_cells_per_s = 0.0;
+};
+
+// Checkpointed global alignment traceback under a memory budget.
+//
+// A forward sweep keeps every k-th score row delta-encoded. The path is then
+// recovered bottom-up: each block of k rows is recomputed from its decoded
+// checkpoint, only up to the path's current column, and traced back.
+// Recomputation is at most one forward sweep plus one block sweep (2nm
+// cells) whatever the budget. The budget covers the store and the transient
+// block together: k is the smallest interval whose checkpoints plus one
+// (k + 1)-row block fit, so fewer checkpoints never buy a block past it.
+// Encoding multiplies the rows a budget can hold by 32 / bits, so blocks
+// shrink by the same factor. When no split fits (a budget under about two
+// raw rows plus two encoded ones), the traceback falls back to Hirschberg,
+// with leaf matrices sized to what is left of the budget.
+class NwCheckpointTraceback {
+public:
+    NwCheckpointTraceback(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, size_t budget_bytes)
+        : s1_(s1), s2_(s2), match_(match), mismatch_(mismatch), gap_(gap), budget_(budget_bytes),
+          codec_(match, mismatch, gap), store_(codec_, s2.length() + 1) {
+        const long long n = s1.length();
+        const size_t encoded = DeltaCheckpointStore::row_bytes(codec_, s2.length() + 1);
+        const size_t raw = (s2.length() + 1) * sizeof(int);
+        const long long capacity = static_cast<long long>(budget_bytes / encoded);
+        // c checkpoints (rows 0, k, 2k, ... up to n, so k = ceil(n / (c - 1))) plus one block of k + 1
+        // rows must fit; the most checkpoints that do give the smallest blocks.
+        bool fits = false;
+        for (long long c = std::min(capacity, n + 1); c >= 2 && !fits; --c) {
+            const long long k = std::max(1LL, (n + c - 2) / (c - 1));
+            fits = static_cast<size_t>(n / k + 1) * encoded + static_cast<size_t>(k + 1) * raw <= budget_bytes;
+            if (fits) interval_ = k;
+        }
+        hirschberg_ = !fits && n > 0;
+    }
+
+    NwAlignment run(NwCheckpointReport& report) {
+        NwAlignment aln;
+        if (hirschberg_) {
+            const long long rows_bytes = static_cast<long long>(2 * (s2_.length() + 1) * sizeof(int));
+            NwTraceback traceback(s1_, s2_, match_, mismatch_, gap_, (static_cast<long long>(budget_) - rows_bytes) / static_cast<long long>(sizeof(int)));
+            aln = traceback.run();
+            report = NwCheckpointReport();
+            report.hirschberg = true;
+            report.peak_bytes = traceback.peak_bytes();
+            return aln;
+        }
+        forward();
+        backtrack(aln);
+        aln.score = aln.rescore(s1_, s2_, match_, mismatch_, gap_);
+
+        report.interval = interval_;
+        report.rows = store_.rows();
+        report.bytes_per_row = DeltaCheckpointStore::row_bytes(codec_, s2_.length() + 1);
+        report.raw_bytes_per_row = (s2_.length() + 1) * sizeof(int);
+        report.store_bytes = store_.bytes();
+        report.peak_bytes = peak_bytes_;
+        report.encode_cells_per_s = store_.encode_cells_per_s();
+        report.decode_cells_per_s = store_.decode_cells_per_s();
+        return aln;
+    }
+
+private:
+    int sub(size_t i, size_t j) const { return (s1_[i] == s2_[j]) ? match_ : mismatch_; }
+
+    void forward() {
+        const size_t n = s1_.length();
+        const size_t m = s2_.length();
+        std::vector<int> row(m + 1);
+        for (size_t j = 0; j <= m; ++j) row[j] = static_cast<int>(j) * gap_;
+        store_.push(row.data());
+        for (size_t i = 1; i <= n; ++i) {
+            int diag = row[0];
+            row[0] += gap_;
+            for (size_t j = 1; j <= m; ++j) {
+                int up = row[j];
+                row[j] = std::max({diag + sub(i - 1, j - 1), up + gap_, row[j - 1] + gap_});
+                diag = up;
+            }
+            if (i % interval_ == 0) store_.push(row.data());
+        }
+        global_metrics.record_recompute(static_cast<long long>(n) * m);
+        global_metrics.record_mem_access(static_cast<long long>(store_.rows()) * (m + 1));
+        global_metrics.update_working_set(store_.bytes() + row.size() * sizeof(int));
+        peak_bytes_ = std::max(peak_bytes_, store_.bytes() + row.size() * sizeof(int));
+    }
+
+    void backtrack(NwAlignment& aln) {
+        size_t i = s1_.length();
+        size_t j = s2_.length();
+        std::string ops;
+        std::vector<int> block;
+        while (i > 0) {
+            const size_t r0 = ((i - 1) / interval_) * interval_;
+            const size_t rows = i - r0;
+            const size_t cols = j;
+            block.resize((rows + 1) * (cols + 1));
+            auto at = [&](size_t r, size_t c) -> int& { return block[r * (cols + 1) + c]; };
+
+            // The path never moves right, so the checkpoint is decoded only up to its column.
+            store_.load(r0 / interval_, block.data(), cols + 1);
+            for (size_t r = 1; r <= rows; ++r) {
+                at(r, 0) = static_cast<int>(r0 + r) * gap_;
+                for (size_t c = 1; c <= cols; ++c) {
+                    at(r, c) = std::max({at(r - 1, c - 1) + sub(r0 + r - 1, c - 1), at(r - 1, c) + gap_, at(r, c - 1) + gap_});
+                }
+            }
+            global_metrics.record_recompute(static_cast<long long>(rows) * cols);
+            global_metrics.update_working_set(store_.bytes() + block.size() * sizeof(int));
+            peak_bytes_ = std::max(peak_bytes_, store_.bytes() + block.size() * sizeof(int));
+
+            // Same tie order as NwTraceback leaves: diagonal, then up, then left.
+            size_t r = rows;
+            while (r > 0) {
+                if (j > 0 && at(r, j) == at(r - 1, j - 1) + sub(r0 + r - 1, j - 1)) { ops += 'M'; --r; --j; }
+                else if (at(r, j) == at(r - 1, j) + gap_) { ops += 'I'; --r; }
+                else { ops += 'D'; --j; }
+            }
+            i = r0;
+        }
+        ops.append(j, 'D');
+        for (size_t k = ops.size(); k-- > 0;) aln.push(ops[k]);
+    }
+
+    const std::string& s1_;
+    const std::string& s2_;
+    int match_;
+    int mismatch_;
+    int gap_;
+    size_t budget_;
+    DeltaRowCodec codec_;
+    DeltaCheckpointStore store_;
+    long long interval_ = 1;
+    bool hirschberg_ = false;
+    size_t peak_bytes_ = 0;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SRF_DP_NW_TILED_H
+#define SRF_DP_NW_TILED_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "../core/srf_utils.hpp"
+#include "../core/packed_sequence.hpp"
+#include "../backends/backend_interface.h"
+#include "../granularity/granularity_policy.h"
+#include "../control/regime_observer.h"
+
+namespace srf {
+
+// Cache-blocked serial Needleman-Wunsch.
+//
+// The matrix is swept in horizontal strips of T rows. Within a strip, T x T
+// tiles run left to right and exchange only boundary vectors:
+//   H[j]  bottom row of the strip above (rewritten with this strip's bottom row)
+//   V[r]  right column of the previous tile in the strip; V[0] is the top-left
+//         corner input of the next tile
+// A tile touches T + 1 row cells, T column cells and T slots of H. The row-major
+// sweep instead streams two full rows of m ints per matrix row. T comes from
+// CacheModel::suggest_tile_size, so even a fully materialised tile would fit the
+// cache budget.
+inline int nw_tiled(const PackedSequence& s1, const PackedSequence& s2, int T, int G,
+                    IBackend* backend, RegimeObserver& observer) {
+    const long long n = s1.length();
+    const long long m = s2.length();
+    if (T < 1) T = 1;
+    if (m == 0) return static_cast<int>(n * -1);
+    if (n == 0) return static_cast<int>(m * -1);
+    GranularityPolicy policy(GranularityType::TILE, G);
+
+    std::vector<int> H(m + 1), V(T + 1), row(T + 1);
+    for (long long j = 0; j <= m; ++j) H[j] = static_cast<int>(j * -1);
+    global_metrics.record_mem_access(m + 1);
+    global_metrics.update_working_set((H.size() + V.size() + row.size()) * sizeof(int));
+
+    for (long long i0 = 1; i0 <= n; i0 += T) {
+        const long long i1 = std::min(n, i0 + T - 1);
+        const long long h = i1 - i0 + 1;
+        V[0] = H[0];
+        for (long long r = 1; r <= h; ++r) V[r] = static_cast<int>((i0 - 1 + r) * -1);
+
+        for (long long j0 = 1; j0 <= m; j0 += T) {
+            const long long j1 = std::min(m, j0 + T - 1);
+            const long long w = j1 - j0 + 1;
+            row[0] = V[0];
+            for (long long c = 1; c <= w; ++c) row[c] = H[j0 - 1 + c];
+            const int next_corner = H[j1];
+
+            for (long long r = 1; r <= h; ++r) {
+                int diag = row[0];
+                row[0] = V[r];
+                const PackedSequence::Query a = s1.query(i0 + r - 2);
+                uint64_t eq = 0;
+                for (long long c = 1; c <= w; ++c) {
+                    if ((c - 1) % 64 == 0) eq = s2.match_mask(j0 - 2 + c, a);
+                    int match_score = ((eq >> ((c - 1) % 64)) & 1) ? 1 : -1;
+                    int up = row[c];
+                    row[c] = backend->nw_cell_compute(diag, up, row[c - 1], match_score, -1);
+                    diag = up;
+                }
+                V[r] = row[w];
+            }
+            for (long long c = 1; c <= w; ++c) H[j0 - 1 + c] = row[c];
+            V[0] = next_corner;
+
+            // Only the strip's bottom row and the tile's right column outlive the tile.
+            const long long cells = h * w;
+            const long long interior = (h - 1) * (w - 1);
+            global_metrics.record_compute(cells);
+            global_metrics.record_mem_access(2 * cells + h);
+            global_metrics.record_recompute(interior);
+            global_metrics.record_reuse(cells - interior);
+            global_metrics.record_unit_recompute(policy.get_unit_id_2d(i0, j0));
+        }
+        H[0] = static_cast<int>(i1 * -1);
+
+        observer.record_snapshot(global_metrics.compute_events,
+                                 global_metrics.recompute_events,
+                                 global_metrics.memory_access_proxy,
+                                 global_metrics.working_set_bytes);
+    }
+    return H[m];
+}
+
+} // namespace srf
+
+#endif
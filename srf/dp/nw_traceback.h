@@ -0,0 +1,188 @@
+#ifndef SRF_DP_NW_TRACEBACK_H
+#define SRF_DP_NW_TRACEBACK_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+
+namespace srf {
+
+// Run-length encoded alignment path. 'M' consumes one base of each sequence,
+// 'I' consumes s1 only and 'D' consumes s2 only.
+struct NwAlignment {
+    std::vector<std::pair<char, long long>> runs;
+    int score = 0;
+
+    void push(char op, long long count = 1) {
+        if (count <= 0) return;
+        if (!runs.empty() && runs.back().first == op) runs.back().second += count;
+        else runs.push_back({op, count});
+    }
+
+    std::string cigar() const {
+        std::string out;
+        for (const auto& r : runs) out += std::to_string(r.second) + r.first;
+        return out;
+    }
+
+    // Re-scores the path against the sequences; equals the DP score for an optimal path.
+    int rescore(const std::string& s1, const std::string& s2, int match, int mismatch, int gap) const {
+        size_t i = 0, j = 0;
+        long long total = 0;
+        for (const auto& r : runs) {
+            for (long long k = 0; k < r.second; ++k) {
+                if (r.first == 'M') { total += (s1[i] == s2[j]) ? match : mismatch; ++i; ++j; }
+                else if (r.first == 'I') { total += gap; ++i; }
+                else { total += gap; ++j; }
+            }
+        }
+        return static_cast<int>(total);
+    }
+};
+
+// Linear-memory global alignment traceback (Hirschberg divide and conquer).
+//
+// Each level splits the row range at its midpoint, recomputes the forward
+// scores of the upper half and the reverse scores of the lower half into two
+// O(m) rows, and cuts at the column maximising their sum. Subproblems of at
+// most leaf_cells cells are finished with a direct full-matrix traceback, so
+// block_width * block_width bounds the largest transient matrix. Every cell
+// evaluated here is a recomputation of the forward pass.
+class NwTraceback {
+public:
+    NwTraceback(const std::string& s1, const std::string& s2, int match, int mismatch, int gap, long long leaf_cells)
+        : s1_(s1), s2_(s2), match_(match), mismatch_(mismatch), gap_(gap),
+          leaf_cells_(leaf_cells > 4 ? leaf_cells : 4),
+          fwd_(s2.length() + 1), rev_(s2.length() + 1) {}
+
+    NwAlignment run() {
+        NwAlignment aln;
+        global_metrics.update_working_set((fwd_.size() + rev_.size()) * sizeof(int) + leaf_cells_ * sizeof(int));
+        peak_bytes_ = (fwd_.size() + rev_.size()) * sizeof(int);
+        solve(0, s1_.length(), 0, s2_.length(), aln);
+        aln.score = path_score(aln);
+        return aln;
+    }
+
+    // Largest footprint of the traceback's own buffers: the two score rows plus the biggest leaf matrix.
+    size_t peak_bytes() const { return peak_bytes_; }
+
+    int path_score(const NwAlignment& aln) const { return aln.rescore(s1_, s2_, match_, mismatch_, gap_); }
+
+    // Expands the path into two gapped strings of equal length.
+    void gapped(const NwAlignment& aln, std::string& top, std::string& bottom) const {
+        size_t i = 0, j = 0;
+        top.clear();
+        bottom.clear();
+        for (const auto& r : aln.runs) {
+            for (long long k = 0; k < r.second; ++k) {
+                top += (r.first == 'D') ? '-' : s1_[i++];
+                bottom += (r.first == 'I') ? '-' : s2_[j++];
+            }
+        }
+    }
+
+private:
+    int sub(size_t i, size_t j) const { return (s1_[i] == s2_[j]) ? match_ : mismatch_; }
+
+    void solve(size_t i0, size_t i1, size_t j0, size_t j1, NwAlignment& aln) {
+        const size_t rows = i1 - i0;
+        const size_t cols = j1 - j0;
+        if (rows == 0) { aln.push('D', cols); return; }
+        if (cols == 0) { aln.push('I', rows); return; }
+        if (rows == 1 || cols == 1 || static_cast<long long>((rows + 1) * (cols + 1)) <= leaf_cells_) {
+            solve_leaf(i0, i1, j0, j1, aln);
+            return;
+        }
+
+        const size_t mid = i0 + rows / 2;
+        forward_row(i0, mid, j0, j1);
+        reverse_row(mid, i1, j0, j1);
+
+        size_t best_j = j0;
+        long long best = static_cast<long long>(fwd_[0]) + rev_[0];
+        for (size_t c = 1; c <= cols; ++c) {
+            long long v = static_cast<long long>(fwd_[c]) + rev_[c];
+            if (v > best) { best = v; best_j = j0 + c; }
+        }
+        global_metrics.record_mem_access(2 * (cols + 1));
+
+        solve(i0, mid, j0, best_j, aln);
+        solve(mid, i1, best_j, j1, aln);
+    }
+
+    // fwd_[c] = best score aligning s1[i0, i_end) with s2[j0, j0 + c).
+    void forward_row(size_t i0, size_t i_end, size_t j0, size_t j1) {
+        const size_t cols = j1 - j0;
+        for (size_t c = 0; c <= cols; ++c) fwd_[c] = static_cast<int>(c) * gap_;
+        for (size_t i = i0; i < i_end; ++i) {
+            int diag = fwd_[0];
+            fwd_[0] += gap_;
+            for (size_t c = 1; c <= cols; ++c) {
+                int up = fwd_[c];
+                fwd_[c] = std::max({diag + sub(i, j0 + c - 1), up + gap_, fwd_[c - 1] + gap_});
+                diag = up;
+            }
+        }
+        global_metrics.record_recompute(static_cast<long long>(i_end - i0) * cols);
+    }
+
+    // rev_[c] = best score aligning s1[i_start, i1) with s2[j0 + c, j1).
+    void reverse_row(size_t i_start, size_t i1, size_t j0, size_t j1) {
+        const size_t cols = j1 - j0;
+        for (size_t c = 0; c <= cols; ++c) rev_[c] = static_cast<int>(cols - c) * gap_;
+        for (size_t i = i1; i-- > i_start;) {
+            int diag = rev_[cols];
+            rev_[cols] += gap_;
+            for (size_t c = cols; c-- > 0;) {
+                int down = rev_[c];
+                rev_[c] = std::max({diag + sub(i, j0 + c), down + gap_, rev_[c + 1] + gap_});
+                diag = down;
+            }
+        }
+        global_metrics.record_recompute(static_cast<long long>(i1 - i_start) * cols);
+    }
+
+    void solve_leaf(size_t i0, size_t i1, size_t j0, size_t j1, NwAlignment& aln) {
+        const size_t rows = i1 - i0;
+        const size_t cols = j1 - j0;
+        std::vector<int> h((rows + 1) * (cols + 1));
+        auto at = [&](size_t r, size_t c) -> int& { return h[r * (cols + 1) + c]; };
+        for (size_t c = 0; c <= cols; ++c) at(0, c) = static_cast<int>(c) * gap_;
+        for (size_t r = 1; r <= rows; ++r) {
+            at(r, 0) = static_cast<int>(r) * gap_;
+            for (size_t c = 1; c <= cols; ++c) {
+                at(r, c) = std::max({at(r - 1, c - 1) + sub(i0 + r - 1, j0 + c - 1), at(r - 1, c) + gap_, at(r, c - 1) + gap_});
+            }
+        }
+        global_metrics.record_recompute(static_cast<long long>(rows) * cols);
+        global_metrics.update_working_set((fwd_.size() + rev_.size() + h.size()) * sizeof(int));
+        peak_bytes_ = std::max(peak_bytes_, (fwd_.size() + rev_.size() + h.size()) * sizeof(int));
+
+        // Trace back from the bottom-right corner, preferring diagonal, then up, then left.
+        std::string ops;
+        size_t r = rows, c = cols;
+        while (r > 0 || c > 0) {
+            if (r > 0 && c > 0 && at(r, c) == at(r - 1, c - 1) + sub(i0 + r - 1, j0 + c - 1)) { ops += 'M'; --r; --c; }
+            else if (r > 0 && at(r, c) == at(r - 1, c) + gap_) { ops += 'I'; --r; }
+            else { ops += 'D'; --c; }
+        }
+        for (size_t k = ops.size(); k-- > 0;) aln.push(ops[k]);
+    }
+
+    const std::string& s1_;
+    const std::string& s2_;
+    int match_;
+    int mismatch_;
+    int gap_;
+    long long leaf_cells_;
+    std::vector<int> fwd_;
+    std::vector<int> rev_;
+    size_t peak_bytes_ = 0;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SRF_DP_NW_WAVEFRONT_H
+#define SRF_DP_NW_WAVEFRONT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+#include "../core/packed_sequence.hpp"
+#include "../runtime/backend_selector.h"
+#include "../runtime/thread_pool.h"
+#include "../granularity/granularity_policy.h"
+#include "../control/regime_observer.h"
+
+namespace srf {
+
+// Tiled anti-diagonal wavefront for Needleman-Wunsch.
+//
+// The (n x m) matrix is cut into B x B tiles. Tile (bi, bj) depends only on
+// (bi-1, bj), (bi, bj-1) and (bi-1, bj-1), so every tile on one anti-diagonal
+// can run concurrently. Only tile boundaries are retained:
+//   H[j]         bottom row of the latest tile finished in column block of j
+//   V[i]         right column of the latest tile finished in row block of i
+//   V_corner[bi] top-right input of the latest tile in row block bi, which is
+//                the top-left corner of its right-hand neighbour
+// Each slot is written by exactly one tile per diagonal, so no locking is needed
+// and the score is bit-identical to the row-major sweep. Match scores come from
+// 64-column match masks of the packed sequences.
+inline int nw_wavefront(const PackedSequence& s1, const PackedSequence& s2, int B, int G, ThreadPool& pool, RegimeObserver& observer) {
+    const long long n = s1.length();
+    const long long m = s2.length();
+    if (B < 1) B = 1;
+    if (m == 0) return static_cast<int>(n * -1);
+    if (n == 0) return static_cast<int>(m * -1);
+
+    const long long row_blocks = (n + B - 1) / B;
+    const long long col_blocks = (m + B - 1) / B;
+    GranularityPolicy policy(GranularityType::TILE, G);
+
+    std::vector<int> H(m + 1), V(n + 1), V_corner(row_blocks);
+    for (long long j = 0; j <= m; ++j) H[j] = static_cast<int>(j * -1);
+    for (long long i = 0; i <= n; ++i) V[i] = static_cast<int>(i * -1);
+    for (long long bi = 0; bi < row_blocks; ++bi) V_corner[bi] = static_cast<int>(bi * B * -1);
+    global_metrics.record_mem_access(m + 1 + n + 1);
+
+    // Per-worker backend and tile row buffer; nothing is shared inside a tile. No tile is wider than m.
+    const size_t row_len = static_cast<size_t>(std::min<long long>(B, m)) + 1;
+    std::vector<std::unique_ptr<IBackend>> backends;
+    std::vector<std::vector<int>> rows(pool.size(), std::vector<int>(row_len));
+    for (size_t w = 0; w < pool.size(); ++w) backends.push_back(BackendSelector::select(1024));
+    global_metrics.update_working_set((H.size() + V.size() + V_corner.size() + pool.size() * row_len) * sizeof(int));
+
+    auto run_tile = [&](long long bi, long long bj, size_t worker) {
+        const long long i0 = bi * B + 1, i1 = std::min(n, (bi + 1) * B);
+        const long long j0 = bj * B + 1, j1 = std::min(m, (bj + 1) * B);
+        const long long w = j1 - j0 + 1;
+        IBackend* backend = backends[worker].get();
+        std::vector<int>& row = rows[worker];
+
+        row[0] = V_corner[bi];
+        for (long long c = 1; c <= w; ++c) row[c] = H[j0 - 1 + c];
+        const int top_right = H[j1];
+
+        for (long long i = i0; i <= i1; ++i) {
+            int diag = row[0];
+            row[0] = V[i];
+            const PackedSequence::Query a = s1.query(i - 1);
+            uint64_t eq = 0;
+            for (long long c = 1; c <= w; ++c) {
+                if ((c - 1) % 64 == 0) eq = s2.match_mask(j0 - 2 + c, a);
+                int match_score = ((eq >> ((c - 1) % 64)) & 1) ? 1 : -1;
+                int up = row[c];
+                row[c] = backend->nw_cell_compute(diag, up, row[c - 1], match_score, -1);
+                diag = up;
+            }
+            V[i] = row[w];
+        }
+        for (long long c = 1; c <= w; ++c) H[j0 - 1 + c] = row[c];
+        V_corner[bi] = top_right;
+
+        // Cells on a B-multiple row or column are retained boundaries; the rest are transient.
+        const long long h = i1 - i0 + 1;
+        const long long cells = h * w;
+        const long long interior = (h - ((i1 % B == 0) ? 1 : 0)) * (w - ((j1 % B == 0) ? 1 : 0));
+        global_metrics.record_compute(cells);
+        global_metrics.record_mem_access(2 * cells + h);
+        global_metrics.record_recompute(interior);
+        global_metrics.record_reuse(cells - interior);
+        global_metrics.record_unit_recompute(policy.get_unit_id_2d(i0, j0));
+    };
+
+    for (long long d = 0; d < row_blocks + col_blocks - 1; ++d) {
+        const long long bi_lo = std::max(0LL, d - (col_blocks - 1));
+        const long long bi_hi = std::min(d, row_blocks - 1);
+        pool.parallel_for(static_cast<size_t>(bi_hi - bi_lo + 1), [&](size_t k, size_t worker) {
+            long long bi = bi_lo + static_cast<long long>(k);
+            run_tile(bi, d - bi, worker);
+        });
+
+        observer.record_snapshot(global_metrics.compute_events,
+                                 global_metrics.recompute_events,
+                                 global_metrics.memory_access_proxy,
+                                 global_metrics.working_set_bytes);
+    }
+    return H[m];
+}
+
+} // namespace srf
+
+#endif
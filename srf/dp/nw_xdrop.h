@@ -0,0 +1,144 @@
+#ifndef SRF_DP_NW_XDROP_H
+#define SRF_DP_NW_XDROP_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+#include "../core/srf_utils.hpp"
+#include "../backends/backend_interface.h"
+#include "../granularity/granularity_policy.h"
+#include "../control/regime_observer.h"
+#include "nw_banded.h"
+
+namespace srf {
+
+struct NwXDropReport {
+    long long best_i = 0;        // Cell of the best extension score
+    long long best_j = 0;
+    long long rows = 0;          // Rows with a non-empty live window
+    long long cells = 0;         // Cells evaluated
+    std::string stop = "end";    // "end", "xdrop" (window emptied) or "zdrop"
+};
+
+// Extension alignment anchored at (0, 0) with X-drop pruning.
+//
+// Row i is evaluated only over the live window inherited from row i - 1
+// (first live column to last live column + 1), extended right while horizontal
+// gaps stay live. A cell scoring below best - X is dead and is never read again.
+// The run stops when a window empties, or, if z_drop > 0, when a row's maximum
+// falls more than z_drop + |gap| * |diagonal offset| below the best cell
+// (minimap2-style Z-drop). The result is the best score over all evaluated
+// cells, which is the usual extension score.
+class NwXDrop {
+public:
+    NwXDrop(const std::string& s1, const std::string& s2, int match, int mismatch, int gap)
+        : s1_(s1), s2_(s2), match_(match), mismatch_(mismatch), gap_(gap) {}
+
+    int run(int x_drop, int z_drop, int B_init, int G, IBackend* backend, RegimeObserver& observer, NwXDropReport& report) {
+        const long long n = s1_.length();
+        const long long m = s2_.length();
+        const long long B = (B_init > 0) ? B_init : 1;
+        GranularityPolicy policy(GranularityType::TILE, G);
+        report = NwXDropReport();
+
+        std::vector<int> prev(m + 1, NEG), curr(m + 1, NEG);
+        global_metrics.update_working_set((prev.size() + curr.size()) * sizeof(int));
+        long long best = 0;
+
+        // Row 0: leading gaps until they drop out of range.
+        long long lo = 0, hi = 0;
+        prev[0] = 0;
+        while (hi + 1 <= m && static_cast<long long>(hi + 1) * gap_ >= best - x_drop) {
+            ++hi;
+            prev[hi] = static_cast<int>(hi * gap_);
+        }
+        global_metrics.record_mem_access(hi + 1);
+
+        for (long long i = 1; i <= n; ++i) {
+            const long long floor_score = best - x_drop;
+            long long new_lo = -1, new_hi = -1;
+            long long row_best = NEG, row_best_j = 0;
+            long long j = lo;
+            const long long j_end = std::min(m, hi + 1);
+            int left = NEG;
+            for (; j <= m; ++j) {
+                int value;
+                if (j == 0) {
+                    value = static_cast<int>(i * gap_);
+                } else {
+                    const int diag = (j - 1 >= lo && j - 1 <= hi) ? prev[j - 1] : NEG;
+                    const int up = (j <= hi) ? prev[j] : NEG;
+                    int match_score = (s1_[i - 1] == s2_[j - 1]) ? match_ : mismatch_;
+                    value = backend->nw_cell_compute(diag, up, left, match_score, gap_);
+                }
+                if (value < floor_score) value = NEG;
+                curr[j] = value;
+                if (value != NEG) {
+                    if (new_lo < 0) new_lo = j;
+                    new_hi = j;
+                    if (value > row_best) { row_best = value; row_best_j = j; }
+                }
+                left = value;
+                // Past the inherited window only a live left neighbour can keep the row going.
+                if (j >= j_end && value == NEG) { ++j; break; }
+            }
+            report.cells += record_row(i, lo, j - 1, B, policy);
+
+            if (new_lo < 0) {
+                report.stop = "xdrop";
+                break;
+            }
+            report.rows = i;
+            if (row_best > best) {
+                best = row_best;
+                report.best_i = i;
+                report.best_j = row_best_j;
+            }
+            std::swap(prev, curr);
+            lo = new_lo;
+            hi = new_hi;
+
+            if (i % B == 0 || i == n) {
+                observer.record_snapshot(global_metrics.compute_events,
+                                         global_metrics.recompute_events,
+                                         global_metrics.memory_access_proxy,
+                                         global_metrics.working_set_bytes);
+            }
+            if (z_drop > 0) {
+                const long long offset = std::llabs((i - report.best_i) - (row_best_j - report.best_j));
+                if (best - row_best > z_drop + static_cast<long long>(-gap_) * offset) {
+                    report.stop = "zdrop";
+                    break;
+                }
+            }
+        }
+        return static_cast<int>(best);
+    }
+
+private:
+    static constexpr int NEG = std::numeric_limits<int>::min() / 4;
+
+    long long record_row(long long i, long long j_lo, long long j_hi, long long B, GranularityPolicy& policy) {
+        if (j_hi < j_lo) return 0;
+        const long long cells = j_hi - j_lo + 1;
+        const long long interior = (i % B != 0) ? count_tile_interior(j_lo, j_hi, B) : 0;
+        global_metrics.record_compute(cells);
+        global_metrics.record_mem_access(2 * cells + 1);
+        global_metrics.record_recompute(interior);
+        global_metrics.record_reuse(cells - interior);
+        global_metrics.record_unit_recompute(policy.get_unit_id_2d(i, j_lo));
+        return cells;
+    }
+
+    const std::string& s1_;
+    const std::string& s2_;
+    int match_;
+    int mismatch_;
+    int gap_;
+};
+
+} // namespace srf
+
+#endif
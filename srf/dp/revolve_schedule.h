@@ -0,0 +1,150 @@
+#ifndef SRF_DP_REVOLVE_SCHEDULE_H
+#define SRF_DP_REVOLVE_SCHEDULE_H
+
+#include <vector>
+#include <algorithm>
+#include "../core/srf_utils.hpp"
+
+namespace srf {
+
+// Binomial (Revolve) checkpoint schedule for reverse sweeps.
+//
+// A reverse sweep visits the states x_{T-1}, ..., x_0 of a forward recursion
+// x_t = step(x_{t-1}), holding at most `slots` states at once (x_0 included).
+// With beta(c, r) = C(c + r, c), the least number of forward steps is
+//   min_steps(T, c) = r * T - C(c + r, c + 1),  with beta(c, r - 1) < T <= beta(c, r)
+// (Griewank & Walther), so each step runs at most r times. The sweep reaches
+// that bound by splitting every range at an argmin of
+//   k + min_steps(l - k, free) + min_steps(k, free + 1).
+class RevolveSchedule {
+public:
+    // min_steps for l states with `slots` held states, the first holding x_0.
+    static long long min_steps(long long l, long long slots) {
+        if (l <= 1) return 0;
+        if (slots <= 1) return l * (l - 1) / 2;
+        long long r = 0;
+        const long long b = binomial_reach(l, slots, r);
+        // C(c + r, c + 1) = beta(c, r) * r / (c + 1)
+        return r * l - b * r / (slots + 1);
+    }
+
+    // Smallest r with beta(slots, r) >= l: the most times any step is repeated.
+    static long long repetitions(long long l, long long slots) {
+        if (l <= 1) return 0;
+        if (slots <= 1) return l - 1;
+        long long r = 0;
+        binomial_reach(l, slots, r);
+        return r;
+    }
+
+    // Steps to advance before storing the next state, for l states with `free`
+    // empty slots. The optimal splits form the range
+    //   [max(beta(c, r - 2), l - beta(c - 1, r)), min(beta(c, r - 1), l - beta(c - 1, r - 1))]
+    // with c = free + 1 and r = repetitions(l, c); the lower end is taken.
+    static long long split(long long l, long long free) {
+        if (free + 1 >= l) return 1;  // Room to store every state: no recomputation.
+        const long long c = free + 1;
+        long long r = 0;
+        const long long b = binomial_reach(l, c, r);                    // beta(c, r)
+        const long long b1 = b * r / (c + r);                           // beta(c, r - 1)
+        const long long b2 = (r >= 2) ? b1 * (r - 1) / (c + r - 1) : 0; // beta(c, r - 2)
+        const long long below = b * c / (c + r);                        // beta(c - 1, r)
+        return std::max({1LL, b2, l - below});
+    }
+
+private:
+    // beta(slots, r) for the smallest r with beta(slots, r) >= l. Every
+    // intermediate is below l * (slots + r), far from overflow for l, slots < 2^31.
+    static long long binomial_reach(long long l, long long slots, long long& r) {
+        long long b = 1;
+        r = 0;
+        while (b < l) {
+            ++r;
+            b = b * (slots + r) / r;
+        }
+        return b;
+    }
+};
+
+// Runs a reverse sweep of T states of `width` doubles on a store of exactly
+// `slots` states, following RevolveSchedule.
+//   init(x)            writes x_0
+//   step(t, in, out)   writes x_t from x_{t-1}
+//   visit(t, x)        receives x_t, for t = T - 1 down to 0
+class RevolveSweep {
+public:
+    RevolveSweep(size_t T, size_t width, size_t slots)
+        : T_(T), width_(width), slots_(std::max<size_t>(1, slots)),
+          store_(slots_ * width), work_(width), next_(width) {}
+
+    size_t slots() const { return slots_; }
+    size_t store_bytes() const { return store_.size() * sizeof(double); }
+    size_t work_bytes() const { return (work_.size() + next_.size()) * sizeof(double); }
+    long long steps() const { return steps_; }
+    long long min_steps() const { return RevolveSchedule::min_steps(static_cast<long long>(T_), static_cast<long long>(slots_)); }
+    long long repetitions() const { return RevolveSchedule::repetitions(static_cast<long long>(T_), static_cast<long long>(slots_)); }
+
+    template <typename Init, typename Step, typename Visit>
+    void run(Init&& init, Step&& step, Visit&& visit) {
+        steps_ = 0;
+        if (T_ == 0) return;
+        global_metrics.update_working_set(store_bytes() + work_bytes());
+        init(&store_[0]);
+
+        // Task i owns slot i, which holds x_{start}; it must visit states start .. start + len - 1.
+        struct Task { size_t start; size_t len; };
+        std::vector<Task> tasks;
+        tasks.reserve(slots_);
+        tasks.push_back({0, T_});
+        while (!tasks.empty()) {
+            Task& task = tasks.back();
+            const size_t depth = tasks.size() - 1;
+            const double* held = &store_[depth * width_];
+            const size_t free = slots_ - tasks.size();
+            if (task.len == 1) {
+                visit(task.start, held);
+                tasks.pop_back();
+            } else if (free == 0) {
+                // No slot left: replay from the held state for every position.
+                for (size_t t = task.start + task.len; t-- > task.start;) {
+                    advance(held, task.start, t, step);
+                    visit(t, t == task.start ? held : work_.data());
+                }
+                tasks.pop_back();
+            } else {
+                const size_t k = static_cast<size_t>(RevolveSchedule::split(static_cast<long long>(task.len), static_cast<long long>(free)));
+                const Task upper = {task.start + k, task.len - k};
+                advance(held, task.start, upper.start, step);
+                std::copy(work_.begin(), work_.end(), store_.begin() + (depth + 1) * width_);
+                global_metrics.record_mem_access(static_cast<long long>(width_));
+                task.len = k;
+                tasks.push_back(upper);
+            }
+        }
+    }
+
+private:
+    // work_ = x_to, stepped forward from x_from held in `from_state`.
+    template <typename Step>
+    void advance(const double* from_state, size_t from, size_t to, Step& step) {
+        if (to == from) return;
+        step(from + 1, from_state, work_.data());
+        for (size_t t = from + 2; t <= to; ++t) {
+            step(t, work_.data(), next_.data());
+            std::swap(work_, next_);
+        }
+        steps_ += static_cast<long long>(to - from);
+    }
+
+    size_t T_;
+    size_t width_;
+    size_t slots_;
+    std::vector<double> store_;
+    std::vector<double> work_;
+    std::vector<double> next_;
+    long long steps_ = 0;
+};
+
+} // namespace srf
+
+#endif
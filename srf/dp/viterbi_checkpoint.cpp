@@ -3,53 +3,65 @@
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <algorithm>
+#include <memory>
 #include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
+#include "../core/record_writer.hpp"
 #include "../runtime/backend_selector.h"
+#include "../runtime/thread_pool.h"
+#include "../runtime/stream_prefetcher.h"
 #include "../granularity/granularity_policy.h"
 #include "../control/drift_detector.h"
 #include "../control/adaptation_policy.h"
+#include "hmm_model.h"
+#include "hmm_dense.h"
+#include "hmm_viterbi_path.h"
+#include "hmm_time_parallel.h"
+#include "hmm_viterbi_stream.h"
 
-enum Observation { Walk, Shop, Clean, OBS_UNKNOWN };
-
-Observation char_to_obs(char c) {
-    if (c == 'A') return Walk;
-    if (c == 'C') return Shop;
-    if (c == 'G') return Clean;
-    return OBS_UNKNOWN;
-}
-
-std::vector<Observation> load_observations(const std::string& path) {
-    std::ifstream f(path);
-    std::string s;
-    f >> s;
-    std::vector<Observation> obs;
-    for(char c : s) obs.push_back(char_to_obs(c));
-    return obs;
+// Divides V by its maximum; returns the log of that maximum.
+double normalise_max(double* V, size_t S) {
+    double top = 0.0;
+    for (size_t s = 0; s < S; ++s) top = std::max(top, V[s]);
+    for (size_t s = 0; s < S; ++s) V[s] /= top;
+    return std::log(top);
 }
 
-double viterbi_granularity_aware(const std::vector<Observation>& obs, int K_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
-    double start_p[] = {0.6, 0.4};
-    double trans_p[2][2] = {{0.7, 0.3}, {0.4, 0.6}};
-    double emit_p[2][4] = {{0.1, 0.4, 0.4, 0.1}, {0.6, 0.2, 0.1, 0.1}};
+// Runs the Viterbi recursion on the dense kernels: two ping-pong state vectors and a
+// flat checkpoint store of one vector per multiple of K, resized only when adaptation
+// changes K. Returns the log probability of the best path. SCALED divides V by its
+// maximum every step; LOG runs max-plus on log probabilities.
+double viterbi_granularity_aware(const srf::DenseHmm& hmm, const std::vector<srf::Observation>& obs, int K_init, int G, srf::HmmArithmetic arith, srf::RegimeObserver& observer) {
     size_t T = obs.size();
-    size_t S = 2;
+    size_t S = hmm.states();
+    if (T == 0) return 0.0;
 
-    int current_K = K_init;
+    int current_K = std::max(1, K_init);
     srf::GranularityPolicy policy(srf::GranularityType::SEGMENT, G);
     srf::DriftDetector detector;
     srf::AdaptationPolicy adapter(100);
 
-    std::vector<std::vector<double>> checkpoints((T / 2) + 1, std::vector<double>(S));
-    std::vector<double> V(S);
-    srf::global_metrics.update_working_set((checkpoints.size() * S + S) * sizeof(double));
+    // One vector per multiple of K in [0, T); resized below whenever adaptation changes K.
+    size_t rows = (T - 1) / current_K + 1;
+    size_t stored = 1;
+    std::vector<double> checkpoints(rows * S);
+    std::vector<double> V(S), next_V(S);
+    std::vector<int> bp(S);
+    srf::global_metrics.update_working_set((checkpoints.size() + S) * sizeof(double));
 
-    for (size_t s = 0; s < S; ++s) {
-        V[s] = start_p[s] * emit_p[s][obs[0]];
-        srf::global_metrics.record_compute(1);
-        srf::global_metrics.record_mem_access();
+    double log_scale = 0.0;
+    if (arith == srf::HmmArithmetic::LOG) {
+        hmm.log_start(obs[0], V.data());
+    } else {
+        hmm.start(obs[0], V.data());
+        if (arith == srf::HmmArithmetic::SCALED) log_scale = normalise_max(V.data(), S);
     }
-    checkpoints[0] = V;
+    srf::global_metrics.record_compute(static_cast<long long>(S));
+    srf::global_metrics.record_mem_access(static_cast<long long>(S));
+    std::copy(V.begin(), V.end(), checkpoints.begin());
 
     for (size_t t = 1; t < T; ++t) {
         bool is_checkpoint = (t % current_K == 0);
@@ -57,17 +69,21 @@ double viterbi_granularity_aware(const std::vector<Observation>& obs, int K_init
             srf::global_metrics.record_recompute(1);
             srf::global_metrics.record_unit_recompute(policy.get_unit_id(t));
         }
-        
-        std::vector<double> next_V(S);
-        for (size_t s = 0; s < S; ++s) {
-            std::vector<double> trans_row = {trans_p[0][s], trans_p[1][s]};
-            next_V[s] = backend->viterbi_step_compute(V, trans_row, emit_p[s][obs[t]]);
-            srf::global_metrics.record_compute(1);
-            srf::global_metrics.record_mem_access();
+
+        if (arith == srf::HmmArithmetic::LOG) {
+            hmm.log_viterbi(V.data(), obs[t], next_V.data(), bp.data());
+        } else {
+            hmm.viterbi(V.data(), obs[t], next_V.data(), bp.data());
+            if (arith == srf::HmmArithmetic::SCALED) log_scale += normalise_max(next_V.data(), S);
+        }
+        srf::global_metrics.record_compute(static_cast<long long>(S));
+        srf::global_metrics.record_mem_access(static_cast<long long>(S));
+        std::swap(V, next_V);
+        if (is_checkpoint && stored < rows) {
+            std::copy(V.begin(), V.end(), checkpoints.begin() + stored * S);
+            ++stored;
         }
-        V = next_V;
-        if (is_checkpoint) checkpoints[t / current_K] = V;
-        
+
         if (t % 10 == 0) {
             observer.record_snapshot(srf::global_metrics.compute_events, 
                                      srf::global_metrics.recompute_events, 
@@ -80,6 +96,13 @@ double viterbi_granularity_aware(const std::vector<Observation>& obs, int K_init
                 int old_K = current_K;
                 current_K += signal.delta;
                 if (current_K < 2) current_K = 2;
+                // Multiples of the new K still ahead; only an adaptation step reallocates.
+                if (current_K != old_K) {
+                    rows = stored + (T - 1) / current_K - t / current_K;
+                    checkpoints.resize(rows * S);
+                    checkpoints.shrink_to_fit();
+                    srf::global_metrics.update_working_set((checkpoints.size() + S) * sizeof(double));
+                }
                 std::cout << "ADAPTATION_EVENT: true" << std::endl;
                 std::cout << "ADAPTATION_REASON: " << signal.reason << std::endl;
                 std::cout << "OLD_PARAM: " << old_K << std::endl;
@@ -88,19 +111,80 @@ double viterbi_granularity_aware(const std::vector<Observation>& obs, int K_init
         }
     }
 
-    double final_max_p = -1.0;
+    double final_max_p = (arith == srf::HmmArithmetic::LOG) ? -HUGE_VAL : -1.0;
     for (size_t s = 0; s < S; ++s) {
         if (V[s] > final_max_p) final_max_p = V[s];
     }
-    return final_max_p;
+    return (arith == srf::HmmArithmetic::LOG) ? final_max_p : log_scale + std::log(final_max_p);
+}
+
+// Forward steps against the binomial minimum for the same number of stored vectors.
+void print_schedule(bool revolve, size_t slots, size_t T, long long steps, long long min_steps) {
+    double sweep = (T > 1) ? static_cast<double>(T - 1) : 1.0;
+    std::cout << "Schedule: " << (revolve ? "binomial" : "stride") << std::endl;
+    if (revolve) std::cout << "Schedule_Slots: " << slots << std::endl;
+    std::cout << "Forward_Steps: " << steps << std::endl;
+    std::cout << "Forward_Steps_Min: " << min_steps << std::endl;
+    std::cout << "Recompute_Factor: " << steps / sweep << std::endl;
+    std::cout << "Recompute_Factor_Min: " << min_steps / sweep << std::endl;
+}
+
+// Segment-parallel forward pass: work beyond one serial sweep.
+void print_scan(const srf::HmmScanReport& scan) {
+    std::cout << "Threads: " << scan.threads << std::endl;
+    std::cout << "Scan_Segments: " << scan.segments << std::endl;
+    std::cout << "Scan_Matrix_Steps: " << scan.matrix_steps << std::endl;
+    std::cout << "Scan_Matrix_Bytes: " << scan.matrix_bytes << std::endl;
+    std::cout << "Scan_Uncertain_Segments: " << scan.uncertain_segments << std::endl;
+    std::cout << "Scan_Fallback_Steps: " << scan.fallback_steps << std::endl;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 4) return 1;
-    std::vector<Observation> obs = load_observations(argv[1]);
-    int K = std::stoi(argv[2]);
-    int G = std::stoi(argv[3]);
-    std::string scale = (argc > 4) ? argv[4] : "NA";
+    // Usage: ./viterbi_checkpoint <seq_path> <segment_length> <group_size> [scale]
+    //                             [--model path] [--arith linear|scaled|log] [--threads N] [--traceback [--path-out path] [--revolve slots]]
+    //                             [--stream [--max-lag N] [--chunk-kb N] [--path-out path]]
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    if (args.positional.size() < 3) return 1;
+    // --stream (implied when seq_path is "-", i.e. stdin) decodes through the prefetcher and commits
+    // the path online, at most --max-lag symbols behind the input.
+    bool streaming = args.has("stream") || args.positional[0] == "-";
+    size_t max_lag = static_cast<size_t>(std::max(0, args.get_int("max-lag", 4096)));
+    size_t chunk_bytes = static_cast<size_t>(std::max(1, args.get_int("chunk-kb", 64))) * 1024;
+    // --model loads an S-state model file (see hmm_model.h) in place of the two-state weather model.
+    srf::HmmModel model = srf::HmmModel::weather();
+    std::string error;
+    if (args.has("model") && !model.load(args.get("model", ""), error)) {
+        std::cerr << "viterbi_checkpoint: " << error << std::endl;
+        return 1;
+    }
+    std::vector<srf::Observation> obs;
+    if (!streaming && !srf::load_observations(args.positional[0], model, obs)) {
+        std::cerr << "viterbi_checkpoint: " << args.positional[0] << " has symbols outside the alphabet " << model.alphabet << std::endl;
+        return 1;
+    }
+    int K = std::stoi(args.positional[1]);
+    int G = std::stoi(args.positional[2]);
+    std::string scale = args.arg(3, "NA");
+    // --traceback recovers the state path from checkpoints every K steps.
+    bool traceback = args.has("traceback");
+    // --revolve C replaces the fixed stride with a binomial schedule on exactly C stored vectors.
+    bool revolve = args.has("revolve");
+    size_t slots = static_cast<size_t>(std::max(1, args.get_int("revolve", 1)));
+    // --threads N runs the checkpointing forward pass segment-parallel in time (0: all hardware threads).
+    bool time_parallel = args.has("threads") && !revolve;
+    int threads = args.get_int("threads", 1);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    // --arith linear|scaled|log sets the plain sweep's arithmetic; the other modes always scale.
+    std::string arith_name = args.get("arith", "scaled");
+    srf::HmmArithmetic arith = srf::HmmArithmetic::SCALED;
+    if (arith_name == "linear") {
+        arith = srf::HmmArithmetic::LINEAR;
+    } else if (arith_name == "log") {
+        arith = srf::HmmArithmetic::LOG;
+    } else if (arith_name != "scaled") {
+        std::cerr << "viterbi_checkpoint: --arith must be linear, scaled or log" << std::endl;
+        return 1;
+    }
 
     auto backend = srf::BackendSelector::select(1024);
     srf::global_metrics.reset();
@@ -108,8 +192,88 @@ int main(int argc, char* argv[]) {
     
     srf::RegimeObserver observer;
 
+    srf::DenseHmm hmm(model);
+    srf::ThreadPool pool(time_parallel ? static_cast<size_t>(threads) : 1);
     auto start_time = std::chrono::high_resolution_clock::now();
-    double result = viterbi_granularity_aware(obs, K, G, backend.get(), observer);
+    double result = 0.0;
+    long long steps = static_cast<long long>(obs.size()) - 1;
+    srf::HmmViterbiReport path_report;
+    srf::HmmScanReport scan;
+    srf::HmmStreamReport stream_report;
+    std::unique_ptr<srf::StreamPrefetcher> stream;
+    double log_probability = 0.0;
+    long long switches = 0;
+    if (streaming) {
+        // Committed states arrive in order, so the path file is appended as they come.
+        std::FILE* path_out = args.has("path-out") ? std::fopen(args.get("path-out", "").c_str(), "wb") : nullptr;
+        int width = 1;
+        for (size_t top = model.states - 1; top >= 10; top /= 10) ++width;
+        int earlier = -1;
+        auto sink = [&](size_t, int state) {
+            if (earlier >= 0 && earlier != state) ++switches;
+            earlier = state;
+            if (path_out) std::fprintf(path_out, "%*d\n", width, state);
+        };
+        stream.reset(new srf::StreamPrefetcher(args.positional[0], chunk_bytes));
+        srf::HmmViterbiStream decoder(hmm, max_lag);
+        bool valid = true;
+        for (const std::vector<char>* chunk = &stream->next(); valid && !chunk->empty(); chunk = &stream->next()) {
+            for (char c : *chunk) {
+                int o = model.encode(c);
+                if (o < 0) { valid = false; break; }
+                decoder.push(static_cast<srf::Observation>(o), sink);
+            }
+        }
+        if (!valid) {
+            std::cerr << "viterbi_checkpoint: " << args.positional[0] << " has symbols outside the alphabet " << model.alphabet << std::endl;
+            if (path_out) std::fclose(path_out);
+            return 1;
+        }
+        log_probability = decoder.finish(sink, stream_report);
+        if (path_out) std::fclose(path_out);
+        result = std::exp(log_probability);
+        steps = std::max(0LL, stream_report.symbols - 1);
+        observer.record_snapshot(srf::global_metrics.compute_events,
+                                 srf::global_metrics.recompute_events,
+                                 srf::global_metrics.memory_access_proxy,
+                                 srf::global_metrics.working_set_bytes);
+    } else if (traceback) {
+        // One right-aligned state index per line, written in place as the backtrace descends.
+        int width = 1;
+        for (size_t top = model.states - 1; top >= 10; top /= 10) ++width;
+        srf::DescendingRecordWriter out(args.get("path-out", ""), width + 1);
+        std::vector<char> line(width + 2);
+        int later = -1;
+        srf::HmmViterbiPath decoder(model, obs, K);
+        if (time_parallel) decoder.set_pool(&pool);
+        auto sink = [&](size_t t, int state) {
+            if (later >= 0 && later != state) ++switches;
+            later = state;
+            if (!out.is_open()) return;
+            std::snprintf(line.data(), line.size(), "%*d\n", width, state);
+            out.put(t, line.data());
+        };
+        log_probability = revolve ? decoder.run_binomial(slots, sink, path_report) : decoder.run(sink, path_report);
+        out.flush();
+        result = std::exp(log_probability);
+        steps = path_report.forward_steps;
+        scan = path_report.scan;
+        observer.record_snapshot(srf::global_metrics.compute_events,
+                                 srf::global_metrics.recompute_events,
+                                 srf::global_metrics.memory_access_proxy,
+                                 srf::global_metrics.working_set_bytes);
+    } else if (time_parallel) {
+        std::vector<double> checkpoints, last;
+        log_probability = srf::HmmTimeParallel(hmm, obs, srf::HmmSemiring::MAX_PRODUCT, pool).run(static_cast<size_t>(K), checkpoints, last, scan);
+        result = std::exp(log_probability);
+        observer.record_snapshot(srf::global_metrics.compute_events,
+                                 srf::global_metrics.recompute_events,
+                                 srf::global_metrics.memory_access_proxy,
+                                 srf::global_metrics.working_set_bytes);
+    } else {
+        log_probability = viterbi_granularity_aware(hmm, obs, K, G, arith, observer);
+        result = std::exp(log_probability);
+    }
     auto end_time = std::chrono::high_resolution_clock::now();
     
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
@@ -121,8 +285,47 @@ int main(int argc, char* argv[]) {
     std::cout << "Algorithm: Viterbi" << std::endl;
     std::cout << "Dataset_Scale: " << scale << std::endl;
     std::cout << "Backend: " << (backend->type() == srf::BackendType::GPU ? "gpu" : "cpu") << std::endl;
+    const bool plain = !streaming && !traceback && !time_parallel;
+    std::cout << "Mode: " << (streaming ? "stream" : (traceback ? "traceback" : (time_parallel ? "parallel" : "viterbi"))) << std::endl;
     std::cout << "Result_Check: " << result << std::endl;
     std::cout << "Time_us: " << duration << std::endl;
+    // Each step is one S x S max-product matrix-vector product.
+    std::cout << "States: " << model.states << std::endl;
+    std::cout << "HMM_Kernel: " << srf::simd_isa_name(hmm.isa()) << std::endl;
+    std::cout << "Transitions_per_s: " << (duration > 0 ? steps * static_cast<double>(model.states * model.states) * 1e6 / duration : 0.0) << std::endl;
+    std::cout << "Arithmetic: " << srf::hmm_arithmetic_name(plain ? arith : srf::HmmArithmetic::SCALED) << std::endl;
+    std::cout << "Path_Log_Probability: " << log_probability << std::endl;
+    if (time_parallel && !streaming) print_scan(scan);
+    if (streaming) {
+        const srf::HmmStreamReport& r = stream_report;
+        std::cout << "Path_Length: " << r.symbols << std::endl;
+        std::cout << "Path_Switches: " << switches << std::endl;
+        std::cout << "Stream_Max_Lag: " << r.max_lag << std::endl;
+        std::cout << "Stream_Committed_Converged: " << r.converged << std::endl;
+        std::cout << "Stream_Committed_Forced: " << r.forced << std::endl;
+        std::cout << "Stream_Committed_Flushed: " << r.flushed << std::endl;
+        std::cout << "Stream_Convergence_Walks: " << r.convergence_walks << std::endl;
+        std::cout << "Stream_Walk_Steps: " << r.walk_steps << std::endl;
+        std::cout << "Stream_Lag_Mean: " << (r.symbols > 0 ? static_cast<double>(r.lag_total) / r.symbols : 0.0) << std::endl;
+        std::cout << "Stream_Lag_Max: " << r.lag_max << std::endl;
+        std::cout << "Stream_Window_Bytes: " << r.window_bytes << std::endl;
+        std::cout << "Stream_Bytes_Read: " << stream->bytes_read() << std::endl;
+        std::cout << "Stream_Wait_us: " << stream->wait_us() << std::endl;
+        std::cout << "Latency_Mean_us: " << r.latency.mean_us() << std::endl;
+        std::cout << "Latency_p50_us: " << r.latency.percentile_us(0.50) << std::endl;
+        std::cout << "Latency_p99_us: " << r.latency.percentile_us(0.99) << std::endl;
+        std::cout << "Latency_Max_us: " << r.latency.max_us() << std::endl;
+    }
+    if (traceback && !streaming) {
+        std::cout << "Path_Length: " << obs.size() << std::endl;
+        std::cout << "Path_Switches: " << switches << std::endl;
+        std::cout << "Path_Checkpoints: " << path_report.checkpoints << std::endl;
+        std::cout << "Path_Checkpoint_Bytes: " << path_report.checkpoint_bytes << std::endl;
+        std::cout << "Path_Backpointer_Bytes: " << path_report.backpointer_bytes << std::endl;
+        std::cout << "Path_Recompute_Steps: " << path_report.recompute_steps << std::endl;
+        print_schedule(revolve, path_report.slots, obs.size(), path_report.forward_steps, path_report.min_forward_steps);
+    }
+    std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
     std::cout << "Drift_State: " << (d_state == srf::DriftState::STABLE ? "STABLE" : (d_state == srf::DriftState::DRIFT_CANDIDATE ? "DRIFT_CANDIDATE" : "INSUFFICIENT_DATA")) << std::endl;
     std::cout << "R_mem: " << latest.r_mem << std::endl;
     std::cout << "R_rec: " << latest.r_rec << std::endl;
@@ -0,0 +1,213 @@
+#ifndef SRF_GRAPH_CSR_GRAPH_H
+#define SRF_GRAPH_CSR_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <sys/stat.h>
+#include "../core/mapped_file.hpp"
+
+namespace srf {
+
+struct CsrEdge {
+    int32_t to;
+    int32_t weight;
+};
+
+// Size and modification time of a graph's text file, recorded in its cache.
+// The time keeps its nanoseconds where the platform reports them, so a file
+// rewritten at the same size within one second still invalidates the cache.
+struct GraphFileStamp {
+    int64_t bytes = -1;
+    int64_t mtime = 0;
+    int64_t mtime_ns = 0;
+
+    static GraphFileStamp of(const std::string& path) {
+        GraphFileStamp stamp;
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            stamp.bytes = static_cast<int64_t>(st.st_size);
+            stamp.mtime = static_cast<int64_t>(st.st_mtime);
+#if defined(__APPLE__) && defined(__MACH__)
+            stamp.mtime_ns = static_cast<int64_t>(st.st_mtimespec.tv_nsec);
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+            stamp.mtime_ns = static_cast<int64_t>(st.st_mtim.tv_nsec);
+#endif
+        }
+        return stamp;
+    }
+};
+
+// Directed graph in compressed sparse row form: the out-edges of u are
+// edges()[offsets()[u] .. offsets()[u + 1]), one packed array for the whole
+// graph, so a sweep over nodes in id order reads edges sequentially.
+//
+// The arrays are either built from a "u v w" text edge list or memory-mapped
+// from a binary .csr cache written by save(). A cache is a fixed header
+// (recording the text file's size and mtime, so a changed file invalidates
+// it) followed by the offsets and edges exactly as held in memory, in native
+// byte order. Where mmap is unavailable the cache is read into memory instead.
+class CsrGraph {
+public:
+    CsrGraph() = default;
+    ~CsrGraph() { release(); }
+
+    CsrGraph(const CsrGraph&) = delete;
+    CsrGraph& operator=(const CsrGraph&) = delete;
+
+    int num_nodes() const { return static_cast<int>(num_nodes_); }
+    size_t num_edges() const { return num_edges_; }
+    const uint64_t* offsets() const { return offsets_; }
+    const CsrEdge* edges() const { return edges_; }
+    size_t bytes() const { return (num_nodes_ + 1) * sizeof(uint64_t) + num_edges_ * sizeof(CsrEdge); }
+    bool mapped() const { return file_.is_open(); }
+
+    // Parses a text edge list, as the baseline loader does: nodes are 0 ..
+    // the largest id seen and every edge costs 1 (the weight column is read
+    // but not used). Edges keep their file order within each source. A
+    // negative node id is an error: nothing is built from the file.
+    bool load_text(const std::string& path, std::string& error) {
+        std::ifstream f(path);
+        if (!f.is_open()) { error = "cannot open " + path; return false; }
+        std::vector<int32_t> sources;
+        std::vector<CsrEdge> unsorted;
+        int u, v, w;
+        int max_node = -1;
+        while (f >> u >> v >> w) {
+            if (u < 0 || v < 0) {
+                error = path + ": negative node id in edge " + std::to_string(sources.size() + 1);
+                return false;
+            }
+            sources.push_back(u);
+            unsorted.push_back({v, 1});
+            if (u > max_node) max_node = u;
+            if (v > max_node) max_node = v;
+        }
+        build(static_cast<size_t>(max_node + 1), sources, unsorted);
+        return true;
+    }
+
+    // Counting sort of (sources[k], edges[k]) by source into the CSR arrays.
+    void build(size_t num_nodes, const std::vector<int32_t>& sources, const std::vector<CsrEdge>& edges) {
+        std::vector<uint64_t> offsets(num_nodes + 1, 0);
+        for (int32_t s : sources) ++offsets[static_cast<size_t>(s) + 1];
+        for (size_t n = 0; n < num_nodes; ++n) offsets[n + 1] += offsets[n];
+        std::vector<CsrEdge> sorted(edges.size());
+        std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+        for (size_t k = 0; k < edges.size(); ++k) sorted[next[sources[k]]++] = edges[k];
+        adopt(num_nodes, std::move(offsets), std::move(sorted));
+    }
+
+    // Takes finished CSR arrays (offsets holds num_nodes + 1 entries).
+    void adopt(size_t num_nodes, std::vector<uint64_t>&& offsets, std::vector<CsrEdge>&& edges) {
+        release();
+        num_nodes_ = num_nodes;
+        num_edges_ = edges.size();
+        owned_offsets_ = std::move(offsets);
+        owned_edges_ = std::move(edges);
+        offsets_ = owned_offsets_.data();
+        edges_ = owned_edges_.data();
+    }
+
+    // Writes the cache for a graph parsed from a file with the given stamp.
+    // The file is written under a temporary name and renamed into place.
+    bool save(const std::string& path, const GraphFileStamp& source) const {
+        const std::string tmp = path + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        Header h = header(source);
+        bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 &&
+                  std::fwrite(offsets_, sizeof(uint64_t), num_nodes_ + 1, f) == num_nodes_ + 1 &&
+                  std::fwrite(edges_, sizeof(CsrEdge), num_edges_, f) == num_edges_;
+        ok = (std::fclose(f) == 0) && ok;
+        if (ok) ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+        if (!ok) std::remove(tmp.c_str());
+        return ok;
+    }
+
+    // Maps a cache. With a stamp (bytes >= 0) the cache must have been
+    // written for a source file of that size and mtime.
+    bool map(const std::string& path, const GraphFileStamp& source, std::string& error) {
+        release();
+        if (!file_.open(path, error)) return false;
+        if (file_.size() < sizeof(Header)) {
+            release();
+            error = path + " is not a graph cache";
+            return false;
+        }
+        file_.advise_sequential();
+        Header h;
+        std::memcpy(&h, file_.data(), sizeof(h));
+        const Header expect = header(source);
+        const size_t size = sizeof(Header) + (h.num_nodes + 1) * sizeof(uint64_t) + h.num_edges * sizeof(CsrEdge);
+        if (std::memcmp(h.magic, expect.magic, sizeof(h.magic)) != 0 || h.version != expect.version ||
+            h.edge_bytes != expect.edge_bytes || size != file_.size()) {
+            release();
+            error = path + " is not a graph cache";
+            return false;
+        }
+        if (source.bytes >= 0 && (h.source_bytes != source.bytes || h.source_mtime != source.mtime ||
+                                  h.source_mtime_ns != source.mtime_ns)) {
+            release();
+            error = path + " is stale";
+            return false;
+        }
+        num_nodes_ = static_cast<size_t>(h.num_nodes);
+        num_edges_ = static_cast<size_t>(h.num_edges);
+        offsets_ = reinterpret_cast<const uint64_t*>(file_.data() + sizeof(Header));
+        edges_ = reinterpret_cast<const CsrEdge*>(offsets_ + num_nodes_ + 1);
+        return true;
+    }
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t edge_bytes;
+        uint64_t num_nodes;
+        uint64_t num_edges;
+        int64_t source_bytes;
+        int64_t source_mtime;
+        int64_t source_mtime_ns;
+    };
+
+    Header header(const GraphFileStamp& source) const {
+        Header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "SRFCSR1", 8);
+        h.version = 2;
+        h.edge_bytes = sizeof(CsrEdge);
+        h.num_nodes = num_nodes_;
+        h.num_edges = num_edges_;
+        h.source_bytes = source.bytes;
+        h.source_mtime = source.mtime;
+        h.source_mtime_ns = source.mtime_ns;
+        return h;
+    }
+
+    void release() {
+        file_.close();
+        owned_offsets_.clear();
+        owned_edges_.clear();
+        offsets_ = nullptr;
+        edges_ = nullptr;
+        num_nodes_ = 0;
+        num_edges_ = 0;
+    }
+
+    size_t num_nodes_ = 0;
+    size_t num_edges_ = 0;
+    const uint64_t* offsets_ = nullptr;
+    const CsrEdge* edges_ = nullptr;
+    std::vector<uint64_t> owned_offsets_;
+    std::vector<CsrEdge> owned_edges_;
+    MappedFile file_;
+};
+
+} // namespace srf
+
+#endif
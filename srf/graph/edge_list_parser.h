@@ -0,0 +1,218 @@
+#ifndef SRF_GRAPH_EDGE_LIST_PARSER_H
+#define SRF_GRAPH_EDGE_LIST_PARSER_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include "../core/mapped_file.hpp"
+#include "../runtime/thread_pool.h"
+#include "csr_graph.h"
+
+namespace srf {
+
+struct EdgeListReport {
+    size_t bytes = 0;          // Text parsed
+    size_t threads = 0;
+    size_t chunks = 0;         // Newline-aligned pieces parsed in parallel
+    bool serial = false;       // Fell back to one sequential scan (irregular layout)
+    long long map_us = 0;
+    long long parse_us = 0;    // Token scan into per-chunk edge arrays
+    long long merge_us = 0;    // Parallel counting sort into CSR
+};
+
+// Parallel "u v w" edge-list loader producing the same CsrGraph as
+// CsrGraph::load_text.
+//
+// The file is memory-mapped and cut into chunks at newline boundaries, which
+// the pool scans with a hand-written integer scanner into per-chunk source
+// and edge arrays. The chunks are then merged by a two-level counting sort:
+// each chunk scatters its edges into one slice per node range (ranges in
+// order, chunks in order within a range), then each range sorts its slice by
+// source, stably, writing its own part of the offsets. Edges of a node
+// therefore keep their file order, exactly as the sequential loader leaves
+// them. The stream extraction loop stops at the first token that is not an
+// int (dropping a partial triple); when a chunk meets such a token, or holds
+// a token count that is not a multiple of three (triples spanning lines),
+// the whole file is scanned sequentially instead, with the same result.
+// A negative node id is an error, as in the sequential loader: parse()
+// returns false, unless the sequential scan stops at a bad token first.
+class EdgeListParser {
+public:
+    explicit EdgeListParser(ThreadPool& pool) : pool_(pool) {}
+
+    bool parse(const std::string& path, CsrGraph& graph, EdgeListReport& report, std::string& error) {
+        report = EdgeListReport();
+        report.threads = pool_.size();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        MappedFile file;
+        if (!file.open(path, error)) return false;
+        file.advise_sequential();
+        const char* text = file.data();
+        const size_t bytes = file.size();
+        report.bytes = bytes;
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        // Chunk boundaries: even splits moved forward past the next newline.
+        const size_t C = std::max<size_t>(1, std::min(bytes / MIN_CHUNK_BYTES + 1, pool_.size() * 4));
+        std::vector<size_t> bounds(C + 1, bytes);
+        bounds[0] = 0;
+        for (size_t c = 1; c < C; ++c) {
+            size_t b = std::max(bounds[c - 1], bytes / C * c);
+            while (b < bytes && b > 0 && text[b - 1] != '\n') ++b;
+            bounds[c] = b;
+        }
+        std::vector<Chunk> chunks(C);
+        pool_.parallel_for(C, [&](size_t c, size_t) {
+            scan(text + bounds[c], text + bounds[c + 1], chunks[c]);
+        });
+        bool regular = true;
+        for (const Chunk& chunk : chunks) regular = regular && chunk.regular;
+        if (!regular) {
+            chunks.assign(1, Chunk());
+            scan(text, text + bytes, chunks[0]);
+            report.serial = true;
+            if (chunks[0].negative) {
+                error = path + ": negative node id in edge " + std::to_string(chunks[0].edges.size() + 1);
+                return false;
+            }
+        }
+        report.chunks = chunks.size();
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        merge(chunks, graph);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        report.map_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        report.parse_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        report.merge_us = std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count();
+        return true;
+    }
+
+private:
+    static constexpr size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+    struct Chunk {
+        std::vector<int32_t> sources;
+        std::vector<CsrEdge> edges;
+        int max_node = -1;
+        bool regular = true;
+        bool negative = false;      // Stopped at an edge with a negative node id
+    };
+
+    static bool is_space(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+    // Reads the next whitespace-delimited int into value, advancing p past it.
+    // Returns 0 at the end of input, -1 for a token that does not start with
+    // an int in range (as operator>> would fail), 1 otherwise. Like operator>>,
+    // it stops at the first non-digit, which the next call then rejects.
+    static int scan_int(const char*& p, const char* end, int& value) {
+        while (p < end && is_space(*p)) ++p;
+        if (p == end) return 0;
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') return -1;
+        long long v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + (*p - '0');
+            if (v > static_cast<long long>(INT_MAX) + 1) return -1;
+            ++p;
+        }
+        if (negative) v = -v;
+        if (v > INT_MAX || v < INT_MIN) return -1;
+        value = static_cast<int>(v);
+        return 1;
+    }
+
+    static void scan(const char* p, const char* end, Chunk& chunk) {
+        // A "u v w" line takes at least six bytes.
+        chunk.sources.reserve(static_cast<size_t>(end - p) / 6);
+        chunk.edges.reserve(static_cast<size_t>(end - p) / 6);
+        int u, v, w;
+        while (true) {
+            const int ru = scan_int(p, end, u);
+            if (ru == 0) return;
+            const int rv = (ru > 0) ? scan_int(p, end, v) : -1;
+            const int rw = (rv > 0) ? scan_int(p, end, w) : -1;
+            if (ru < 0 || rv <= 0 || rw <= 0 || u < 0 || v < 0) {
+                chunk.negative = (ru > 0 && rv > 0 && rw > 0);
+                chunk.regular = false;
+                return;
+            }
+            chunk.sources.push_back(u);
+            chunk.edges.push_back({v, 1});
+            chunk.max_node = std::max(chunk.max_node, std::max(u, v));
+        }
+    }
+
+    void merge(const std::vector<Chunk>& chunks, CsrGraph& graph) {
+        int max_node = -1;
+        size_t m = 0;
+        for (const Chunk& chunk : chunks) {
+            max_node = std::max(max_node, chunk.max_node);
+            m += chunk.edges.size();
+        }
+        const size_t n = static_cast<size_t>(max_node + 1);
+        const size_t C = chunks.size();
+        const size_t R = std::max<size_t>(1, std::min(pool_.size(), n));
+        const size_t span = std::max<size_t>(1, (n + R - 1) / R);
+
+        // Edges per (chunk, node range), then each pair's start in the range-major scatter.
+        std::vector<size_t> start(C * R, 0);
+        pool_.parallel_for(C, [&](size_t c, size_t) {
+            for (int32_t s : chunks[c].sources) ++start[c * R + static_cast<size_t>(s) / span];
+        });
+        std::vector<size_t> range_start(R + 1, 0);
+        size_t pos = 0;
+        for (size_t r = 0; r < R; ++r) {
+            range_start[r] = pos;
+            for (size_t c = 0; c < C; ++c) {
+                const size_t count = start[c * R + r];
+                start[c * R + r] = pos;
+                pos += count;
+            }
+        }
+        range_start[R] = pos;
+
+        std::vector<int32_t> sources(m);
+        std::vector<CsrEdge> scattered(m);
+        pool_.parallel_for(C, [&](size_t c, size_t) {
+            std::vector<size_t> next(start.begin() + c * R, start.begin() + (c + 1) * R);
+            const Chunk& chunk = chunks[c];
+            for (size_t k = 0; k < chunk.edges.size(); ++k) {
+                const size_t at = next[static_cast<size_t>(chunk.sources[k]) / span]++;
+                sources[at] = chunk.sources[k];
+                scattered[at] = chunk.edges[k];
+            }
+        });
+
+        std::vector<uint64_t> offsets(n + 1, 0);
+        std::vector<CsrEdge> edges(m);
+        pool_.parallel_for(R, [&](size_t r, size_t) {
+            const size_t lo = std::min(n, r * span);
+            const size_t hi = std::min(n, lo + span);
+            if (lo == hi) return;
+            for (size_t k = range_start[r]; k < range_start[r + 1]; ++k) ++offsets[static_cast<size_t>(sources[k]) + 1];
+            std::vector<uint64_t> next(hi - lo);
+            uint64_t running = range_start[r];
+            for (size_t u = lo; u < hi; ++u) {
+                next[u - lo] = running;
+                running += offsets[u + 1];
+                offsets[u + 1] = running;
+            }
+            for (size_t k = range_start[r]; k < range_start[r + 1]; ++k) {
+                edges[next[static_cast<size_t>(sources[k]) - lo]++] = scattered[k];
+            }
+        });
+        graph.adopt(n, std::move(offsets), std::move(edges));
+    }
+
+    ThreadPool& pool_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef SRF_GRAPH_GRAPH_DP_BOUNDED_H
+#define SRF_GRAPH_GRAPH_DP_BOUNDED_H
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include "../granularity/granularity_policy.h"
+#include "csr_graph.h"
+
+namespace srf {
+
+struct GraphBoundedReport {
+    size_t span_nodes = 0;          // group_depth groups: the most a value is ever replayed over
+    size_t budget_bytes = 0;        // 0: no cap
+    size_t peak_bytes = 0;          // Node values held at once (blocks, checkpoints, replay buffer)
+    size_t full_bytes = 0;          // A resident dist array, for comparison
+    size_t checkpoints_peak = 0;    // Live span checkpoints held at once
+    size_t evicted_blocks = 0;      // Pending blocks dropped (or never allocated) to stay in budget
+    size_t rebuilt_spans = 0;       // Spans whose incoming values were recomputed
+    long long replayed_nodes = 0;   // Node steps re-run from checkpoints
+    long long relaxations = 0;      // Forward edges relaxed by the sweep itself
+};
+
+// Graph-DP in memory bounded by a budget rather than by the node count.
+//
+// Like the id-order sweep, it fixes dist[u] on reaching u and pushes it along
+// u's forward edges (back edges never reach the result). Nodes are grouped by
+// the GROUP policy, and group_depth groups form a span. Only three kinds of
+// node values are held:
+//   - the current span's values;
+//   - pending blocks: one per later span, holding the best value pushed into
+//     it so far. This is the frontier: a block exists only once an edge
+//     reaches the span, and is consumed when the sweep gets there;
+//   - checkpoints: a span's incoming values as the sweep entered it. A
+//     checkpoint is kept while a reachable node of the span still has an edge
+//     ahead of the sweep, and dropped when the span falls out of liveness.
+// Finished values are dropped once their span is done.
+//
+// Every allocation goes through one make-room step: while the values held
+// plus the new buffer would pass the budget, the farthest pending block is
+// evicted and its span marked dirty; further pushes into it are skipped. A
+// new pending block must also leave room for the scratch of a span change
+// (one block on top of the current span and its checkpoint copy, which a
+// rebuild needs), so blocks are not kept only to be evicted at the next span.
+// When the sweep enters a dirty span it recomputes the span's incoming
+// values: every live earlier span is replayed from its checkpoint, which
+// re-runs at most group_depth groups, and its edges into the span are
+// applied. Checkpoints, the current span and the replay buffer are never
+// evicted, so the budget holds whenever it covers them (about three blocks
+// plus the live checkpoints); below that the peak reports by how much.
+class BoundedGraphDp {
+public:
+    static constexpr int UNREACHED = 1000000000;
+
+    BoundedGraphDp(const GranularityPolicy& policy, int group_depth, size_t budget_bytes)
+        : span_(static_cast<size_t>(policy.unit_size()) * static_cast<size_t>(std::max(1, group_depth))),
+          budget_(budget_bytes) {}
+
+    // Returns dist[num_nodes - 1] (0 for an empty graph).
+    int run(const CsrGraph& graph, GraphBoundedReport& report) {
+        report_ = GraphBoundedReport();
+        report_.span_nodes = span_;
+        report_.budget_bytes = budget_;
+        n_ = static_cast<size_t>(graph.num_nodes());
+        report_.full_bytes = n_ * sizeof(int);
+        offsets_ = graph.offsets();
+        edges_ = graph.edges();
+        pending_.clear();
+        checkpoints_.clear();
+        expiry_ = ExpiryQueue();
+        held_ = 0;
+        int result = 0;
+        if (n_ > 0) {
+            dirty_.assign((n_ + span_ - 1) / span_, false);
+            for (size_t k = 0; k < dirty_.size(); ++k) result = sweep_span(k);
+        }
+        pending_.clear();
+        checkpoints_.clear();
+        report = report_;
+        return result;
+    }
+
+private:
+    struct Checkpoint {
+        std::vector<int> incoming;  // Empty when nothing reached the span from before it
+        size_t last_use = 0;        // Farthest forward target of a reachable node in the span
+    };
+
+    size_t block_bytes() const { return span_ * sizeof(int); }
+    size_t lo(size_t k) const { return k * span_; }
+    size_t hi(size_t k) const { return std::min(n_, (k + 1) * span_); }
+
+    void hold(size_t bytes) {
+        held_ += bytes;
+        report_.peak_bytes = std::max(report_.peak_bytes, held_);
+    }
+    void release(size_t bytes) { held_ -= bytes; }
+
+    int sweep_span(size_t k) {
+        std::vector<int> block = take(k);
+        if (k == 0) block[0] = 0;
+        const size_t begin = lo(k), end = hi(k);
+
+        Checkpoint checkpoint;
+        if (std::any_of(block.begin(), block.end(), [](int d) { return d != UNREACHED; })) {
+            hold(make_room(block_bytes(), k));
+            checkpoint.incoming = block;
+        }
+        for (size_t u = begin; u < end; ++u) {
+            const int du = block[u - begin];
+            if (du == UNREACHED) continue;
+            for (uint64_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                const size_t v = static_cast<size_t>(edges_[e].to);
+                if (v <= u) continue;
+                ++report_.relaxations;
+                const int candidate = du + edges_[e].weight;
+                checkpoint.last_use = std::max(checkpoint.last_use, v);
+                if (v < end) {
+                    block[v - begin] = std::min(block[v - begin], candidate);
+                } else {
+                    push(v, candidate);
+                }
+            }
+        }
+        const int last = (end == n_) ? block[n_ - 1 - begin] : UNREACHED;
+        release(block_bytes());
+
+        // Checkpoints whose span has no edge past this one can never be replayed again.
+        while (!expiry_.empty() && expiry_.top().first < end) {
+            auto it = checkpoints_.find(expiry_.top().second);
+            release(it->second.incoming.size() * sizeof(int));
+            checkpoints_.erase(it);
+            expiry_.pop();
+        }
+        if (checkpoint.last_use >= end) {
+            expiry_.emplace(checkpoint.last_use, k);
+            checkpoints_.emplace(k, std::move(checkpoint));
+            report_.checkpoints_peak = std::max(report_.checkpoints_peak, checkpoints_.size());
+        } else {
+            release(checkpoint.incoming.size() * sizeof(int));
+        }
+        return last;
+    }
+
+    // The incoming values of span k: its pending block, a recomputed one if it was evicted, or none.
+    std::vector<int> take(size_t k) {
+        if (dirty_[k]) return rebuild(k);
+        auto it = pending_.find(k);
+        if (it == pending_.end()) {
+            hold(make_room(block_bytes(), k));
+            return std::vector<int>(span_, UNREACHED);
+        }
+        std::vector<int> block = std::move(it->second);
+        pending_.erase(it);
+        return block;
+    }
+
+    void push(size_t v, int candidate) {
+        const size_t s = v / span_;
+        if (dirty_[s]) return;
+        auto it = pending_.find(s);
+        if (it == pending_.end()) {
+            make_room(2 * block_bytes(), s);
+            if (budget_ > 0 && held_ + 2 * block_bytes() > budget_) {
+                dirty_[s] = true;
+                ++report_.evicted_blocks;
+                return;
+            }
+            hold(block_bytes());
+            it = pending_.emplace(s, std::vector<int>(span_, UNREACHED)).first;
+        }
+        int& slot = it->second[v - lo(s)];
+        slot = std::min(slot, candidate);
+    }
+
+    // Evicts pending blocks after span keep, farthest first, until bytes more fit; returns bytes.
+    size_t make_room(size_t bytes, size_t keep) {
+        while (budget_ > 0 && held_ + bytes > budget_ && !pending_.empty() && pending_.rbegin()->first > keep) {
+            evict(std::prev(pending_.end()));
+        }
+        return bytes;
+    }
+
+    void evict(std::map<size_t, std::vector<int>>::iterator it) {
+        dirty_[it->first] = true;
+        release(block_bytes());
+        pending_.erase(it);
+        ++report_.evicted_blocks;
+    }
+
+    std::vector<int> rebuild(size_t k) {
+        ++report_.rebuilt_spans;
+        hold(make_room(2 * block_bytes(), k));
+        std::vector<int> block(span_, UNREACHED);
+        std::vector<int> values(span_);
+        const size_t begin = lo(k), end = hi(k);
+        for (const auto& entry : checkpoints_) {
+            replay(entry.first, entry.second, values);
+            const size_t from = lo(entry.first), to = hi(entry.first);
+            for (size_t u = from; u < to; ++u) {
+                const int du = values[u - from];
+                if (du == UNREACHED) continue;
+                for (uint64_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                    const size_t v = static_cast<size_t>(edges_[e].to);
+                    if (v >= begin && v < end) block[v - begin] = std::min(block[v - begin], du + edges_[e].weight);
+                }
+            }
+        }
+        release(block_bytes());
+        return block;
+    }
+
+    // Re-runs span j from its checkpoint, leaving the span's final values in values.
+    void replay(size_t j, const Checkpoint& checkpoint, std::vector<int>& values) {
+        if (checkpoint.incoming.empty()) {
+            std::fill(values.begin(), values.end(), UNREACHED);
+        } else {
+            std::copy(checkpoint.incoming.begin(), checkpoint.incoming.end(), values.begin());
+        }
+        const size_t begin = lo(j), end = hi(j);
+        report_.replayed_nodes += static_cast<long long>(end - begin);
+        for (size_t u = begin; u < end; ++u) {
+            const int du = values[u - begin];
+            if (du == UNREACHED) continue;
+            for (uint64_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                const size_t v = static_cast<size_t>(edges_[e].to);
+                if (v > u && v < end) values[v - begin] = std::min(values[v - begin], du + edges_[e].weight);
+            }
+        }
+    }
+
+    size_t span_;
+    size_t budget_;
+    size_t n_ = 0;
+    const uint64_t* offsets_ = nullptr;
+    const CsrEdge* edges_ = nullptr;
+    size_t held_ = 0;
+    std::vector<bool> dirty_;                       // One flag per span
+    std::map<size_t, std::vector<int>> pending_;    // Span -> best values pushed into it so far
+    std::map<size_t, Checkpoint> checkpoints_;      // Live spans
+    using ExpiryQueue = std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>,
+                                            std::greater<std::pair<size_t, size_t>>>;
+    ExpiryQueue expiry_;                            // (last_use, span) of each live checkpoint
+    GraphBoundedReport report_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef SRF_GRAPH_GRAPH_DP_LEVELS_H
+#define SRF_GRAPH_GRAPH_DP_LEVELS_H
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "../runtime/thread_pool.h"
+#include "csr_graph.h"
+
+namespace srf {
+
+struct GraphLevelReport {
+    size_t threads = 0;
+    size_t levels = 0;            // Topological levels of the forward-edge DAG
+    size_t max_width = 0;         // Nodes in the widest level
+    size_t parallel_levels = 0;   // Levels with enough edges to be split across the pool
+    size_t back_edges = 0;        // Edges u -> v with v <= u (applied after the sweep)
+    long long relaxations = 0;    // Edges leaving a reachable node
+};
+
+// Level-synchronous form of the id-order sweep in graph_recompute and
+// baselines/graph/graph_dp.cpp.
+//
+// That sweep fixes dist[u] when it reaches u, so only forward edges (u < v)
+// carry values onward: a back edge lowers its target after the target has
+// been read and nothing further depends on it. The sweep is therefore a DAG
+// DP over the forward edges, and id order is already a topological order of
+// that DAG; back edges are applied in one pass at the end.
+//
+// The forward DAG is walked in Kahn levels: every node of a level has all
+// its predecessors in earlier levels, so its value is final. Each level's
+// out-edges are relaxed concurrently with an atomic min on the target, and
+// an atomic in-degree countdown hands a target to the next level when its
+// last predecessor is done. Neither step takes a lock, and min is
+// order-independent, so the values match the sweep for any thread count.
+// Levels with fewer than min_parallel_edges out-edges run on the calling
+// thread, which keeps narrow (chain-like) stretches free of pool barriers.
+class LevelDagDp {
+public:
+    static constexpr int UNREACHED = 1000000000;
+
+    LevelDagDp(ThreadPool& pool, size_t min_parallel_edges = 4096)
+        : pool_(pool), min_parallel_edges_(std::max<size_t>(1, min_parallel_edges)) {}
+
+    // Returns dist[num_nodes - 1] (0 for an empty graph), leaving all values in dist().
+    int run(const CsrGraph& graph, GraphLevelReport& report) {
+        report = GraphLevelReport();
+        report.threads = pool_.size();
+        const size_t n = static_cast<size_t>(graph.num_nodes());
+        const uint64_t* offsets = graph.offsets();
+        const CsrEdge* edges = graph.edges();
+        dist_ = std::vector<std::atomic<int>>(n);
+        pending_ = std::vector<std::atomic<int>>(n);
+        if (n == 0) return 0;
+
+        // Forward in-degrees, counted over node ranges.
+        const size_t ranges = std::min(n, pool_.size() * 4);
+        const size_t span = (n + ranges - 1) / ranges;
+        std::vector<size_t> back(ranges, 0);
+        pool_.parallel_for(ranges, [&](size_t r, size_t) {
+            for (size_t u = r * span; u < std::min(n, (r + 1) * span); ++u) {
+                dist_[u].store(UNREACHED, std::memory_order_relaxed);
+                pending_[u].store(0, std::memory_order_relaxed);
+            }
+        });
+        pool_.parallel_for(ranges, [&](size_t r, size_t) {
+            for (size_t u = r * span; u < std::min(n, (r + 1) * span); ++u) {
+                for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                    if (static_cast<size_t>(edges[k].to) > u) {
+                        pending_[edges[k].to].fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        ++back[r];
+                    }
+                }
+            }
+        });
+        for (size_t b : back) report.back_edges += b;
+        dist_[0].store(0, std::memory_order_relaxed);
+
+        std::vector<std::vector<int32_t>> next(pool_.size());
+        std::vector<long long> relaxed(pool_.size(), 0);
+        std::vector<int32_t> level;
+        for (size_t u = 0; u < n; ++u) {
+            if (pending_[u].load(std::memory_order_relaxed) == 0) level.push_back(static_cast<int32_t>(u));
+        }
+        while (!level.empty()) {
+            ++report.levels;
+            report.max_width = std::max(report.max_width, level.size());
+            size_t level_edges = 0;
+            for (int32_t u : level) level_edges += offsets[u + 1] - offsets[u];
+            if (level_edges < min_parallel_edges_ || pool_.size() == 1) {
+                relax(level.data(), level.size(), offsets, edges, next[0], relaxed[0]);
+            } else {
+                ++report.parallel_levels;
+                const size_t blocks = std::min(level.size(), pool_.size() * 8);
+                const size_t per_block = (level.size() + blocks - 1) / blocks;
+                pool_.parallel_for(blocks, [&](size_t b, size_t worker) {
+                    const size_t lo = std::min(level.size(), b * per_block);
+                    const size_t hi = std::min(level.size(), lo + per_block);
+                    relax(level.data() + lo, hi - lo, offsets, edges, next[worker], relaxed[worker]);
+                });
+            }
+            level.clear();
+            for (std::vector<int32_t>& part : next) {
+                level.insert(level.end(), part.begin(), part.end());
+                part.clear();
+            }
+        }
+
+        // Back edges read the final forward value of their source.
+        pool_.parallel_for(ranges, [&](size_t r, size_t worker) {
+            for (size_t u = r * span; u < std::min(n, (r + 1) * span); ++u) {
+                const int du = dist_[u].load(std::memory_order_relaxed);
+                if (du == UNREACHED) continue;
+                for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                    if (static_cast<size_t>(edges[k].to) > u) continue;
+                    relax_min(edges[k].to, du + edges[k].weight);
+                    ++relaxed[worker];
+                }
+            }
+        });
+        for (long long r : relaxed) report.relaxations += r;
+        return dist_[n - 1].load(std::memory_order_relaxed);
+    }
+
+    int dist(size_t u) const { return dist_[u].load(std::memory_order_relaxed); }
+    size_t bytes() const { return dist_.size() * (sizeof(std::atomic<int>) * 2); }
+
+private:
+    void relax_min(int32_t v, int candidate) {
+        int current = dist_[v].load(std::memory_order_relaxed);
+        while (candidate < current &&
+               !dist_[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Relaxes the forward edges of nodes[0 .. count), collecting targets whose last predecessor this was.
+    void relax(const int32_t* nodes, size_t count, const uint64_t* offsets, const CsrEdge* edges,
+               std::vector<int32_t>& ready, long long& relaxed) {
+        for (size_t i = 0; i < count; ++i) {
+            const size_t u = static_cast<size_t>(nodes[i]);
+            const int du = dist_[u].load(std::memory_order_relaxed);
+            for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                const int32_t v = edges[k].to;
+                if (static_cast<size_t>(v) <= u) continue;
+                if (du != UNREACHED) {
+                    relax_min(v, du + edges[k].weight);
+                    ++relaxed;
+                }
+                if (pending_[v].fetch_sub(1, std::memory_order_acq_rel) == 1) ready.push_back(v);
+            }
+        }
+    }
+
+    ThreadPool& pool_;
+    size_t min_parallel_edges_;
+    std::vector<std::atomic<int>> dist_;
+    std::vector<std::atomic<int>> pending_;
+};
+
+} // namespace srf
+
+#endif
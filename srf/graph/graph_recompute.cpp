@@ -3,36 +3,23 @@
 #include <fstream>
 #include <algorithm>
 #include <chrono>
+#include <string>
 #include "../core/srf_utils.hpp"
+#include "../core/srf_cli.hpp"
 #include "../runtime/backend_selector.h"
 #include "../granularity/granularity_policy.h"
 #include "../control/drift_detector.h"
 #include "../control/adaptation_policy.h"
+#include "../runtime/thread_pool.h"
+#include "csr_graph.h"
+#include "edge_list_parser.h"
+#include "graph_dp_levels.h"
+#include "graph_dp_bounded.h"
 
-struct Edge {
-    int to;
-    int weight;
-};
-
-std::vector<std::vector<Edge>> load_graph(const std::string& path, int& num_nodes) {
-    std::ifstream f(path);
-    int u, v, w;
-    std::vector<std::pair<int, int>> temp_edges;
-    int max_node = -1;
-    while (f >> u >> v >> w) {
-        temp_edges.push_back({u, v});
-        if (u > max_node) max_node = u;
-        if (v > max_node) max_node = v;
-    }
-    num_nodes = max_node + 1;
-    std::vector<std::vector<Edge>> adj(num_nodes);
-    for(auto& e : temp_edges) {
-        adj[e.first].push_back({e.second, 1});
-    }
-    return adj;
-}
-
-int graph_granularity_aware(int num_nodes, const std::vector<std::vector<Edge>>& adj, int depth_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
+int graph_granularity_aware(const srf::CsrGraph& graph, int depth_init, int G, srf::IBackend* backend, srf::RegimeObserver& observer) {
+    const int num_nodes = graph.num_nodes();
+    const uint64_t* offsets = graph.offsets();
+    const srf::CsrEdge* edges = graph.edges();
     if (num_nodes == 0) return 0;
     std::vector<int> dist(num_nodes, 1e9);
     dist[0] = 0;
@@ -43,16 +30,18 @@ int graph_granularity_aware(int num_nodes, const std::vector<std::vector<Edge>>&
     srf::GranularityPolicy policy(srf::GranularityType::GROUP, G);
     srf::DriftDetector detector;
     srf::AdaptationPolicy adapter(50);
+    std::vector<int> pred_dists(1), weights(1);
 
     for (int u = 0; u < num_nodes; ++u) {
         if (dist[u] == 1e9) continue;
         srf::global_metrics.record_mem_access();
-        for (const auto& edge : adj[u]) {
+        for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+            const srf::CsrEdge& edge = edges[k];
             srf::global_metrics.record_recompute(current_D);
             srf::global_metrics.record_unit_recompute(policy.get_unit_id(u));
             
-            std::vector<int> pred_dists = {dist[u]};
-            std::vector<int> weights = {edge.weight};
+            pred_dists[0] = dist[u];
+            weights[0] = edge.weight;
             int new_dist = backend->graph_node_compute(pred_dists, weights);
             srf::global_metrics.record_compute(1);
             srf::global_metrics.record_mem_access();
@@ -86,22 +75,128 @@ int graph_granularity_aware(int num_nodes, const std::vector<std::vector<Edge>>&
     return dist[num_nodes - 1];
 }
 
+// Level-synchronous parallel DP; metrics are recorded once for the whole run.
+int graph_levels(const srf::CsrGraph& graph, int depth, int G, srf::ThreadPool& pool, srf::RegimeObserver& observer, srf::GraphLevelReport& report) {
+    srf::LevelDagDp engine(pool);
+    int result = engine.run(graph, report);
+    srf::GranularityPolicy policy(srf::GranularityType::GROUP, G);
+    srf::global_metrics.update_working_set(engine.bytes());
+    srf::global_metrics.record_recompute(report.relaxations * depth);
+    srf::global_metrics.record_compute(report.relaxations);
+    srf::global_metrics.record_mem_access(report.relaxations * 3 + graph.num_nodes());
+    if (graph.num_nodes() > 0) srf::global_metrics.record_unit_recompute(policy.get_unit_id(graph.num_nodes() - 1));
+    observer.record_snapshot(srf::global_metrics.compute_events,
+                             srf::global_metrics.recompute_events,
+                             srf::global_metrics.memory_access_proxy,
+                             srf::global_metrics.working_set_bytes);
+    return result;
+}
+
+// Bounded-memory DP: node values are evicted and recomputed from group checkpoints.
+int graph_bounded(const srf::CsrGraph& graph, int depth, int G, size_t budget_bytes, srf::RegimeObserver& observer, srf::GraphBoundedReport& report) {
+    srf::GranularityPolicy policy(srf::GranularityType::GROUP, G);
+    srf::BoundedGraphDp engine(policy, depth, budget_bytes);
+    int result = engine.run(graph, report);
+    srf::global_metrics.update_working_set(report.peak_bytes);
+    srf::global_metrics.record_recompute(report.replayed_nodes);
+    srf::global_metrics.record_compute(report.relaxations);
+    srf::global_metrics.record_mem_access(report.relaxations * 3 + graph.num_nodes());
+    observer.record_snapshot(srf::global_metrics.compute_events,
+                             srf::global_metrics.recompute_events,
+                             srf::global_metrics.memory_access_proxy,
+                             srf::global_metrics.working_set_bytes);
+    return result;
+}
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 4) return 1;
-    int num_nodes = 0;
-    auto adj = load_graph(argv[1], num_nodes);
-    int recompute_depth = std::stoi(argv[2]);
-    int G = std::stoi(argv[3]);
-    std::string scale = (argc > 4) ? argv[4] : "NA";
+    // Usage: ./graph_recompute <graph_path> <group_depth> <group_size> [scale] [--cache [path]]
+    //                         [--parser parallel|stream] [--parse-threads N] [--threads N]
+    //                         [--budget-kb N]
+    srf::CliArgs args = srf::parse_cli(argc, argv);
+    if (args.positional.size() < 3) return 1;
+    std::string path = args.positional[0];
+    int recompute_depth = std::stoi(args.positional[1]);
+    int G = std::stoi(args.positional[2]);
+    std::string scale = args.arg(3, "NA");
+    // --parser stream reads the text with one ifstream loop instead of the parallel mmap parser.
+    std::string parser_name = args.get("parser", "parallel");
+    if (parser_name != "parallel" && parser_name != "stream") {
+        std::cerr << "graph_recompute: unknown parser " << parser_name << std::endl;
+        return 1;
+    }
+    int parse_threads = args.get_int("parse-threads", 0);
+    if (parse_threads < 1) parse_threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    // --budget-kb N runs the bounded-memory DP, holding at most N KB of node values (0: no cap).
+    bool bounded = args.has("budget-kb");
+    size_t budget_bytes = static_cast<size_t>(std::max(0, args.get_int("budget-kb", 0))) * 1024;
+    // --threads N runs the level-synchronous parallel DP (0: all hardware threads).
+    bool levels = args.has("threads") && !bounded;
+    int threads = args.get_int("threads", 1);
+    if (threads < 1) threads = static_cast<int>(srf::ThreadPool::hardware_threads());
+    srf::EdgeListReport parse_report;
+    bool parsed = false;
+    long long parse_us = 0;
+    auto load_text = [&](srf::CsrGraph& g, std::string& err) {
+        parsed = true;
+        auto parse_start = std::chrono::high_resolution_clock::now();
+        bool ok;
+        if (parser_name == "stream") {
+            ok = g.load_text(path, err);
+        } else {
+            srf::ThreadPool pool(static_cast<size_t>(parse_threads));
+            ok = srf::EdgeListParser(pool).parse(path, g, parse_report, err);
+        }
+        auto parse_end = std::chrono::high_resolution_clock::now();
+        parse_us = std::chrono::duration_cast<std::chrono::microseconds>(parse_end - parse_start).count();
+        return ok;
+    };
+
+    // --cache maps a binary CSR cache (default <graph_path>.csr), writing it from the text
+    // file first when it is missing or stale. A .csr graph_path is mapped directly.
+    srf::CsrGraph graph;
+    std::string error;
+    std::string source = "text";
+    bool loaded = false;
+    auto load_start = std::chrono::high_resolution_clock::now();
+    if (ends_with(path, ".csr")) {
+        loaded = graph.map(path, srf::GraphFileStamp(), error);
+        source = "cache";
+    } else if (args.has("cache")) {
+        std::string cache_path = args.get("cache", "1") == "1" ? path + ".csr" : args.get("cache", "");
+        srf::GraphFileStamp stamp = srf::GraphFileStamp::of(path);
+        if (graph.map(cache_path, stamp, error)) {
+            loaded = true;
+            source = "cache";
+        } else if ((loaded = load_text(graph, error)) && graph.save(cache_path, stamp)) {
+            source = "text+cache-write";
+        }
+    } else {
+        loaded = load_text(graph, error);
+    }
+    if (!loaded) {
+        std::cerr << "graph_recompute: " << error << std::endl;
+        return 1;
+    }
+    auto load_end = std::chrono::high_resolution_clock::now();
+    auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(load_end - load_start).count();
 
     auto backend = srf::BackendSelector::select(1024);
     srf::global_metrics.reset();
     backend->reset_metrics();
     
     srf::RegimeObserver observer;
+    srf::ThreadPool pool(levels ? static_cast<size_t>(threads) : 1);
+    srf::GraphLevelReport level_report;
+    srf::GraphBoundedReport bounded_report;
 
     auto start_time = std::chrono::high_resolution_clock::now();
-    int result = graph_granularity_aware(num_nodes, adj, recompute_depth, G, backend.get(), observer);
+    int result = bounded ? graph_bounded(graph, recompute_depth, G, budget_bytes, observer, bounded_report)
+                 : levels ? graph_levels(graph, recompute_depth, G, pool, observer, level_report)
+                          : graph_granularity_aware(graph, recompute_depth, G, backend.get(), observer);
     auto end_time = std::chrono::high_resolution_clock::now();
     
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
@@ -115,6 +210,43 @@ int main(int argc, char* argv[]) {
     std::cout << "Backend: " << (backend->type() == srf::BackendType::GPU ? "gpu" : "cpu") << std::endl;
     std::cout << "Result_Check: " << result << std::endl;
     std::cout << "Time_us: " << duration << std::endl;
+    std::cout << "Engine: " << (bounded ? "bounded" : (levels ? "levels" : "sweep")) << std::endl;
+    if (bounded) {
+        std::cout << "Span_Nodes: " << bounded_report.span_nodes << std::endl;
+        std::cout << "Budget_Bytes: " << bounded_report.budget_bytes << std::endl;
+        std::cout << "Value_Bytes_Peak: " << bounded_report.peak_bytes << std::endl;
+        std::cout << "Value_Bytes_Full: " << bounded_report.full_bytes << std::endl;
+        std::cout << "Budget_Met: " << (bounded_report.budget_bytes == 0 || bounded_report.peak_bytes <= bounded_report.budget_bytes ? "true" : "false") << std::endl;
+        std::cout << "Checkpoints_Peak: " << bounded_report.checkpoints_peak << std::endl;
+        std::cout << "Evicted_Blocks: " << bounded_report.evicted_blocks << std::endl;
+        std::cout << "Rebuilt_Spans: " << bounded_report.rebuilt_spans << std::endl;
+        std::cout << "Replayed_Nodes: " << bounded_report.replayed_nodes << std::endl;
+        std::cout << "Recompute_Factor: " << (graph.num_nodes() > 0 ? static_cast<double>(bounded_report.replayed_nodes) / graph.num_nodes() : 0.0) << std::endl;
+    }
+    if (levels) {
+        std::cout << "Threads: " << level_report.threads << std::endl;
+        std::cout << "Levels: " << level_report.levels << std::endl;
+        std::cout << "Level_Width_Max: " << level_report.max_width << std::endl;
+        std::cout << "Parallel_Levels: " << level_report.parallel_levels << std::endl;
+        std::cout << "Back_Edges: " << level_report.back_edges << std::endl;
+        std::cout << "Relaxations: " << level_report.relaxations << std::endl;
+        std::cout << "Relaxations_per_s: " << (duration > 0 ? level_report.relaxations * 1e6 / duration : 0.0) << std::endl;
+    }
+    std::cout << "Graph_Source: " << source << std::endl;
+    std::cout << "Nodes: " << graph.num_nodes() << std::endl;
+    std::cout << "Edges: " << graph.num_edges() << std::endl;
+    std::cout << "Graph_Bytes: " << graph.bytes() << std::endl;
+    std::cout << "Load_us: " << load_us << std::endl;
+    if (parsed) {
+        std::cout << "Parser: " << parser_name << std::endl;
+        if (parser_name == "parallel") {
+            std::cout << "Parse_Threads: " << parse_report.threads << std::endl;
+            std::cout << "Parse_Chunks: " << parse_report.chunks << (parse_report.serial ? " (serial fallback)" : "") << std::endl;
+            std::cout << "Parse_Phase_us: " << parse_report.map_us << " " << parse_report.parse_us << " " << parse_report.merge_us << std::endl;
+        }
+        std::cout << "Parse_us: " << parse_us << std::endl;
+        std::cout << "Parse_MB_per_s: " << (parse_us > 0 ? srf::GraphFileStamp::of(path).bytes / static_cast<double>(parse_us) : 0.0) << std::endl;
+    }
     std::cout << "Memory_kb: " << srf::get_peak_rss() << std::endl;
     
     // Logging
@@ -10,8 +10,21 @@ std::unique_ptr<IBackend> BackendSelector::select(size_t device_budget_kb) {
     const char* force_gpu = std::getenv("SRF_FORCE_GPU");
     const char* force_cpu = std::getenv("SRF_FORCE_CPU");
 
+    // SRF_CPU_KERNEL=simd[-scalar|-sse41|-avx2|-avx512] enables the vectorized CPU kernels
+    // (the ISA suffix caps the instruction set; unsupported requests are clamped down).
+    const char* cpu_kernel = std::getenv("SRF_CPU_KERNEL");
+    CpuKernelMode mode = CpuKernelMode::CELL;
+    SimdIsa isa = SimdIsa::AVX512;
+    if (cpu_kernel) {
+        std::string k(cpu_kernel);
+        if (k.compare(0, 4, "simd") == 0) mode = CpuKernelMode::SIMD;
+        if (k == "simd-scalar") isa = SimdIsa::SCALAR;
+        if (k == "simd-sse41") isa = SimdIsa::SSE41;
+        if (k == "simd-avx2") isa = SimdIsa::AVX2;
+    }
+
     if (force_cpu) {
-        return std::make_unique<CpuBackend>();
+        return std::make_unique<CpuBackend>(mode, isa);
     }
 
     // A GPU backend can be simulated for testing by setting this environment variable.
@@ -20,7 +33,7 @@ std::unique_ptr<IBackend> BackendSelector::select(size_t device_budget_kb) {
     }
 
     // Default to CPU backend.
-    return std::make_unique<CpuBackend>();
+    return std::make_unique<CpuBackend>(mode, isa);
 }
 
 } // namespace srf
@@ -0,0 +1,87 @@
+#include "stream_prefetcher.h"
+#include <chrono>
+
+namespace srf {
+
+StreamPrefetcher::StreamPrefetcher(const std::string& path, size_t chunk_bytes)
+    : chunk_bytes_(chunk_bytes > 0 ? chunk_bytes : 1), raw_(chunk_bytes_) {
+    if (path == "-") {
+        file_ = stdin;
+    } else {
+        file_ = std::fopen(path.c_str(), "rb");
+        owns_file_ = true;
+    }
+    buffers_[0].reserve(chunk_bytes_);
+    buffers_[1].reserve(chunk_bytes_);
+    if (file_) {
+        producer_ = std::thread(&StreamPrefetcher::producer_loop, this);
+    } else {
+        finished_ = true;
+        full_[0] = true;  // A single empty chunk: nothing to read.
+    }
+}
+
+StreamPrefetcher::~StreamPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (producer_.joinable()) producer_.join();
+    if (file_ && owns_file_) std::fclose(file_);
+}
+
+const std::vector<char>& StreamPrefetcher::next() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (consumer_slot_ >= 0) {
+        // Hand the chunk just consumed back to the producer.
+        if (buffers_[consumer_slot_].empty()) return buffers_[consumer_slot_];
+        full_[consumer_slot_] = false;
+        cv_.notify_all();
+    }
+    const int slot = (consumer_slot_ < 0) ? 0 : 1 - consumer_slot_;
+    auto t0 = std::chrono::steady_clock::now();
+    cv_.wait(lock, [&] { return full_[slot]; });
+    wait_us_ += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+    consumer_slot_ = slot;
+    return buffers_[slot];
+}
+
+void StreamPrefetcher::producer_loop() {
+    int slot = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return stop_ || !full_[slot]; });
+            if (stop_) return;
+        }
+        fill(buffers_[slot]);
+        const bool last = buffers_[slot].empty();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            full_[slot] = true;
+        }
+        cv_.notify_all();
+        if (last) return;
+        slot = 1 - slot;
+    }
+}
+
+void StreamPrefetcher::fill(std::vector<char>& out) {
+    out.clear();
+    while (!finished_ && out.size() < chunk_bytes_) {
+        if (raw_pos_ == raw_len_) {
+            raw_len_ = std::fread(raw_.data(), 1, raw_.size(), file_);
+            raw_pos_ = 0;
+            bytes_read_ += static_cast<long long>(raw_len_);
+            if (raw_len_ == 0) {
+                finished_ = true;
+                break;
+            }
+        }
+        raw_pos_ += parser_.feed(raw_.data() + raw_pos_, raw_len_ - raw_pos_, out, chunk_bytes_);
+        finished_ = parser_.finished();
+    }
+}
+
+} // namespace srf
@@ -0,0 +1,68 @@
+#ifndef SRF_RUNTIME_STREAM_PREFETCHER_H
+#define SRF_RUNTIME_STREAM_PREFETCHER_H
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+#include "../core/sequence_parser.hpp"
+
+namespace srf {
+
+// Double-buffered sequence reader. A background thread reads the input
+// (a path, or stdin for "-") and parses it into one of two chunk buffers
+// while the consumer works on the other, so I/O overlaps compute and only two
+// chunks (plus one raw read buffer of the same size) are ever resident. The
+// bases come from the same SequenceParser as load_packed_sequence, so a
+// streamed file (plain or FASTA) yields exactly the sequence a loaded one does.
+class StreamPrefetcher {
+public:
+    StreamPrefetcher(const std::string& path, size_t chunk_bytes);
+    ~StreamPrefetcher();
+
+    StreamPrefetcher(const StreamPrefetcher&) = delete;
+    StreamPrefetcher& operator=(const StreamPrefetcher&) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // Next chunk of sequence bytes, valid until the following call. An empty
+    // chunk marks the end of the sequence.
+    const std::vector<char>& next();
+
+    size_t chunk_bytes() const { return chunk_bytes_; }
+    long long bytes_read() const { return bytes_read_; }
+    long long wait_us() const { return wait_us_; }   // Consumer time blocked on I/O
+
+private:
+    void producer_loop();
+    // Parses raw input into out until it holds chunk_bytes_ bases or the sequence ends.
+    void fill(std::vector<char>& out);
+
+    std::FILE* file_ = nullptr;
+    bool owns_file_ = false;
+    size_t chunk_bytes_;
+    std::vector<char> raw_;
+    size_t raw_pos_ = 0;
+    size_t raw_len_ = 0;
+
+    // Parser state, touched only by the producer thread.
+    SequenceParser parser_;
+    bool finished_ = false;
+
+    std::vector<char> buffers_[2];
+    bool full_[2] = {false, false};
+    int consumer_slot_ = -1;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::atomic<long long> bytes_read_{0};
+    long long wait_us_ = 0;
+    std::thread producer_;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,73 @@
+#include "thread_pool.h"
+
+namespace srf {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads < 1) num_threads = 1;
+    for (size_t w = 1; w < num_threads; ++w) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+size_t ThreadPool::hardware_threads() {
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+void ThreadPool::drain(size_t worker_id) {
+    size_t idx;
+    while ((idx = next_index_.fetch_add(1)) < job_count_) {
+        (*job_)(idx, worker_id);
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    if (workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        next_index_ = 0;
+        active_ = workers_.size();
+        generation_++;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return active_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::worker_loop(size_t worker_id) {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) return;
+            seen_generation = generation_;
+        }
+        drain(worker_id);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) done_cv_.notify_one();
+        }
+    }
+}
+
+} // namespace srf
@@ -0,0 +1,48 @@
+#ifndef SRF_RUNTIME_THREAD_POOL_H
+#define SRF_RUNTIME_THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+namespace srf {
+
+// Fixed-size pool for bulk-synchronous phases (e.g. one wavefront diagonal).
+// The calling thread takes part as worker 0, so a pool of size 1 runs inline.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    // Runs fn(index, worker_id) for every index in [0, count) and blocks until all complete.
+    void parallel_for(size_t count, const std::function<void(size_t, size_t)>& fn);
+
+    static size_t hardware_threads();
+
+private:
+    void worker_loop(size_t worker_id);
+    void drain(size_t worker_id);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(size_t, size_t)>* job_ = nullptr;
+    size_t job_count_ = 0;
+    std::atomic<size_t> next_index_{0};
+    size_t generation_ = 0;
+    size_t active_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace srf
+
+#endif
@@ -0,0 +1,78 @@
+#include "work_stealing_pool.h"
+
+namespace srf {
+
+WorkStealingPool::WorkStealingPool(size_t num_workers) {
+    if (num_workers < 1) num_workers = 1;
+    for (size_t w = 0; w < num_workers; ++w) queues_.push_back(std::make_unique<WorkerQueue>());
+    for (size_t w = 0; w < num_workers; ++w) workers_.emplace_back(&WorkStealingPool::worker_loop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait_idle();
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t target = next_queue_.fetch_add(1) % queues_.size();
+    pending_++;
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        queued_++;
+    }
+    wake_cv_.notify_one();
+}
+
+void WorkStealingPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    idle_cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool WorkStealingPool::try_pop(size_t worker_id, Task& task) {
+    WorkerQueue& q = *queues_[worker_id];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::try_steal(size_t worker_id, Task& task) {
+    for (size_t k = 1; k < queues_.size(); ++k) {
+        WorkerQueue& q = *queues_[(worker_id + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        steals_++;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::worker_loop(size_t worker_id) {
+    while (true) {
+        Task task;
+        if (try_pop(worker_id, task) || try_steal(worker_id, task)) {
+            queued_--;
+            task(worker_id);
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            if (--pending_ == 0) idle_cv_.notify_all();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) return;
+    }
+}
+
+} // namespace srf
@@ -0,0 +1,62 @@
+#ifndef SRF_RUNTIME_WORK_STEALING_POOL_H
+#define SRF_RUNTIME_WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+namespace srf {
+
+// Task pool with one deque per worker. Submitted tasks are dealt round-robin;
+// a worker pops from the back of its own deque and, when empty, steals from
+// the front of the others. Tasks receive the id of the worker running them so
+// callers can keep per-worker state (backends, DP buffers) without locking.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(size_t)>;
+
+    explicit WorkStealingPool(size_t num_workers);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return queues_.size(); }
+
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished.
+    void wait_idle();
+
+    long long steal_count() const { return steals_; }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool try_pop(size_t worker_id, Task& task);
+    bool try_steal(size_t worker_id, Task& task);
+    void worker_loop(size_t worker_id);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable idle_cv_;
+    std::atomic<long long> queued_{0};
+    std::atomic<long long> pending_{0};
+    std::atomic<long long> steals_{0};
+    std::atomic<size_t> next_queue_{0};
+    bool stop_ = false;
+};
+
+} // namespace srf
+
+#endif
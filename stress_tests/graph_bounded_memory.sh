@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Bounded-Memory Graph-DP Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/graph_bounded_memory_log.csv"
+PLATFORM=$(uname)
+GRAPHS=${SRF_GRAPHS:-"datasets/graphs/processed/go_subset_xl.txt datasets_extreme/graphs/graph_250000.txt datasets_extreme/pathological/graph_layered.txt"}
+# group_depth 4 x group_size 256: 1024-node spans, 4 KB blocks of node values.
+DEPTH=${SRF_GROUP_DEPTH:-4}
+GROUP=${SRF_GROUP_SIZE:-256}
+# "none" runs the id-order sweep with a resident dist array; 0 is the bounded engine without a cap.
+BUDGETS=${SRF_GRAPH_BUDGETS:-"none 0 256 64 32 16 8 4"}
+
+mkdir -p results/csv
+echo "algorithm,platform,graph,nodes,edges,group_depth,group_size,engine,budget_kb,value_bytes_peak,value_bytes_full,budget_met,checkpoints_peak,evicted_blocks,rebuilt_spans,recompute_factor,runtime_us,peak_rss_kb,result_check,baseline_check,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for GRAPH in $GRAPHS; do
+    if [ ! -s "$GRAPH" ]; then
+        echo "Skipping $GRAPH (missing or empty)"
+        continue
+    fi
+    base=$(field "$(./build/graph_dp "$GRAPH")" Result_Check)
+    # Map a CSR cache so peak RSS is not dominated by text parsing.
+    CACHE=$(mktemp)
+    ./build/graph_recompute "$GRAPH" $DEPTH $GROUP EXTREME --cache "$CACHE" > /dev/null
+    for B in $BUDGETS; do
+        if [ "$B" = "none" ]; then
+            output=$(./build/graph_recompute "$GRAPH" $DEPTH $GROUP EXTREME --cache "$CACHE")
+        else
+            output=$(./build/graph_recompute "$GRAPH" $DEPTH $GROUP EXTREME --cache "$CACHE" --budget-kb $B)
+        fi
+        check=$(field "$output" Result_Check)
+        status=Success
+        [ "$check" = "$base" ] || status=Mismatch
+        echo "Testing $(basename "$GRAPH") budget=$B KB: Value_Bytes_Peak=$(field "$output" Value_Bytes_Peak) Recompute_Factor=$(field "$output" Recompute_Factor) Time_us=$(field "$output" Time_us) $status"
+        echo "graph_recompute,$PLATFORM,$(basename "$GRAPH" .txt),$(field "$output" Nodes),$(field "$output" Edges),$DEPTH,$GROUP,$(field "$output" Engine),$B,$(field "$output" Value_Bytes_Peak),$(field "$output" Value_Bytes_Full),$(field "$output" Budget_Met),$(field "$output" Checkpoints_Peak),$(field "$output" Evicted_Blocks),$(field "$output" Rebuilt_Spans),$(field "$output" Recompute_Factor),$(field "$output" Time_us),$(field "$output" Memory_kb),$check,$base,$status" >> $CSV_FILE
+    done
+    rm -f "$CACHE"
+done
+
+echo "[SRF] Bounded-memory Graph-DP benchmark finished."
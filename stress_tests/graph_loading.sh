@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Graph Loading Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/graph_loading_log.csv"
+PLATFORM=$(uname)
+SIZES=${SRF_GRAPH_SIZES:-"10000 50000 100000 250000"}
+THREADS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+PARALLEL_RUNS="--parser=parallel,--parse-threads=1"
+if [ "$THREADS" -gt 1 ]; then PARALLEL_RUNS="$PARALLEL_RUNS --parser=parallel,--parse-threads=$THREADS"; fi
+
+mkdir -p results/csv
+echo "algorithm,platform,nodes,edges,source,parser,parse_threads,parse_mb_per_s,load_us,dp_us,total_us,graph_bytes,peak_rss_kb,result_check,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for size in $SIZES; do
+    GRAPH="datasets_extreme/graphs/graph_$size.txt"
+    CACHE=$(mktemp)
+    # The baseline builds one adjacency vector per node; only its peak RSS is comparable.
+    base=$(./build/graph_dp "$GRAPH")
+    echo "graph_dp,$PLATFORM,$size,,vector-of-vectors,,,,,,,,$(field "$base" Memory_kb),$(field "$base" Result_Check),Success" >> $CSV_FILE
+    for RUN in "--parser=stream" $PARALLEL_RUNS "--cache=$CACHE" "--cache=$CACHE"; do
+        ARGS=$(echo "$RUN" | tr ',=' '  ')
+        start=$(date +%s%N)
+        output=$(./build/graph_recompute "$GRAPH" 4 1 EXTREME $ARGS)
+        total=$(( ($(date +%s%N) - start) / 1000 ))
+        source=$(field "$output" Graph_Source)
+        echo "Testing $size nodes ($source, $ARGS): Parse_MB_per_s=$(field "$output" Parse_MB_per_s) Load_us=$(field "$output" Load_us) Memory_kb=$(field "$output" Memory_kb)"
+        echo "graph_recompute,$PLATFORM,$(field "$output" Nodes),$(field "$output" Edges),$source,$(field "$output" Parser),$(field "$output" Parse_Threads),$(field "$output" Parse_MB_per_s),$(field "$output" Load_us),$(field "$output" Time_us),$total,$(field "$output" Graph_Bytes),$(field "$output" Memory_kb),$(field "$output" Result_Check),Success" >> $CSV_FILE
+    done
+    rm -f "$CACHE"
+done
+
+echo "[SRF] Graph loading benchmark finished."
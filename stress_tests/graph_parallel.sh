@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Level-Parallel Graph-DP Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/graph_parallel_log.csv"
+PLATFORM=$(uname)
+GRAPHS=${SRF_GRAPHS:-"datasets_extreme/graphs/graph_10000.txt datasets_extreme/graphs/graph_50000.txt datasets_extreme/graphs/graph_100000.txt datasets_extreme/graphs/graph_250000.txt datasets_extreme/pathological/graph_layered.txt"}
+# 0 runs the id-order sweep; the default sweeps 1 .. all cores in powers of two.
+CORES=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+if [ -z "$SRF_GRAPH_THREADS" ]; then
+    SRF_GRAPH_THREADS="0"
+    N=1
+    while [ $N -lt $CORES ]; do SRF_GRAPH_THREADS="$SRF_GRAPH_THREADS $N"; N=$((N * 2)); done
+    SRF_GRAPH_THREADS="$SRF_GRAPH_THREADS $CORES"
+fi
+
+mkdir -p results/csv
+echo "algorithm,platform,graph,nodes,edges,engine,threads,levels,level_width_max,parallel_levels,runtime_us,relaxations_per_s,result_check,baseline_check,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for GRAPH in $GRAPHS; do
+    base=$(field "$(./build/graph_dp "$GRAPH")" Result_Check)
+    for N in $SRF_GRAPH_THREADS; do
+        if [ "$N" = "0" ]; then
+            output=$(./build/graph_recompute "$GRAPH" 4 1 EXTREME)
+        else
+            output=$(./build/graph_recompute "$GRAPH" 4 1 EXTREME --threads $N)
+        fi
+        check=$(field "$output" Result_Check)
+        status=Success
+        [ "$check" = "$base" ] || status=Mismatch
+        echo "Testing $(basename "$GRAPH") ($(field "$output" Engine), $N threads): Time_us=$(field "$output" Time_us) Levels=$(field "$output" Levels) $status"
+        echo "graph_recompute,$PLATFORM,$(basename "$GRAPH" .txt),$(field "$output" Nodes),$(field "$output" Edges),$(field "$output" Engine),$N,$(field "$output" Levels),$(field "$output" Level_Width_Max),$(field "$output" Parallel_Levels),$(field "$output" Time_us),$(field "$output" Relaxations_per_s),$check,$base,$status" >> $CSV_FILE
+    done
+done
+
+echo "[SRF] Level-parallel Graph-DP benchmark finished."
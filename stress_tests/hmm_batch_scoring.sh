@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Batched HMM Scoring Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/hmm_batch_scoring_log.csv"
+PLATFORM=$(uname)
+# 20000 reads of 50-300 symbols from scripts/generate_hmm_models.py.
+READS="datasets_extreme/models/reads_20000.txt"
+LANE_VALUES=${SRF_HMM_LANES:-"8 16 32"}
+STATE_VALUES=${SRF_HMM_STATES:-"2 32"}
+
+if [ ! -f "$READS" ]; then
+    python3 scripts/generate_hmm_models.py
+fi
+
+mkdir -p results/csv
+echo "algorithm,platform,sequences,states,kernel,order,lanes,masked_fraction,runtime_us,sequences_per_s,transitions_per_s,peak_rss_kb,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for S in $STATE_VALUES; do
+    MODEL="datasets_extreme/models/random_s$S.hmm"
+    for KERNEL in cell simd; do
+        for ORDER in sorted unsorted; do
+            FLAGS=""
+            if [ "$ORDER" = "unsorted" ]; then FLAGS="--unsorted"; fi
+            for L in $LANE_VALUES; do
+                echo "Testing S=$S kernel=$KERNEL $ORDER with $L lanes..."
+                output=$(SRF_CPU_KERNEL=$KERNEL ./build/hmm_batch "$READS" $L EXTREME --model "$MODEL" $FLAGS)
+                runtime=$(field "$output" Time_us)
+                masked=$(field "$output" Masked_Fraction)
+                echo "  Time_us=$runtime Masked_Fraction=$masked Kernel=$(field "$output" Kernel)"
+                echo "hmm_batch,$PLATFORM,$(field "$output" Sequences),$S,$(field "$output" Kernel),$ORDER,$L,$masked,$runtime,$(field "$output" Sequences_per_s),$(field "$output" Transitions_per_s),$(field "$output" Memory_kb),Success" >> $CSV_FILE
+            done
+        done
+    done
+done
+
+echo "[SRF] Batched HMM scoring benchmark finished."
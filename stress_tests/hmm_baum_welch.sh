@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Baum-Welch Training Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/hmm_baum_welch_log.csv"
+PLATFORM=$(uname)
+# 20000 reads of 50-300 symbols from scripts/generate_hmm_models.py, and one T = 1M sequence (split into segments).
+READS="datasets_extreme/models/reads_20000.txt"
+LONG="datasets_extreme/sequences/seq_a_1000000.txt"
+MODEL="datasets_extreme/models/random_s8.hmm"
+ITERATIONS=3
+THREAD_VALUES=${SRF_HMM_THREADS:-"1 2 4 8"}
+
+if [ ! -f "$READS" ]; then
+    python3 scripts/generate_hmm_models.py
+fi
+
+mkdir -p results/csv
+echo "algorithm,platform,input,sequences,observations,states,threads,iterations,work_units,split_sequences,unit_bytes,runtime_us,transitions_per_s,log_likelihood,peak_rss_kb,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for INPUT in "$READS" "$LONG"; do
+    for N in $THREAD_VALUES; do
+        echo "Testing Baum-Welch on $INPUT with $N threads..."
+        output=$(./build/hmm_train "$INPUT" $ITERATIONS EXTREME --model "$MODEL" --threads $N)
+        runtime=$(field "$output" Time_us)
+        echo "  Time_us=$runtime Work_Units=$(field "$output" Work_Units) Log_Likelihood=$(field "$output" Log_Likelihood)"
+        echo "baum_welch,$PLATFORM,$(basename "$INPUT"),$(field "$output" Sequences),$(field "$output" Observations),$(field "$output" States),$N,$(field "$output" Iterations),$(field "$output" Work_Units),$(field "$output" Split_Sequences),$(field "$output" Unit_Bytes_Max),$runtime,$(field "$output" Transitions_per_s),$(field "$output" Log_Likelihood),$(field "$output" Memory_kb),Success" >> $CSV_FILE
+    done
+done
+
+echo "[SRF] Baum-Welch training benchmark finished."
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting HMM State-Count Scaling Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/hmm_state_scaling_log.csv"
+PLATFORM=$(uname)
+SEQ="datasets_extreme/sequences/seq_a_10000.txt"
+# Random models from scripts/generate_hmm_models.py; each step costs S^2 transitions.
+STATE_VALUES=${SRF_HMM_STATES:-"2 8 32 128 256 512"}
+
+if [ ! -f "datasets_extreme/models/random_s512.hmm" ]; then
+    python3 scripts/generate_hmm_models.py
+fi
+
+mkdir -p results/csv
+echo "algorithm,platform,length,states,arithmetic,kernel,runtime_us,transitions_per_s,log_result,peak_rss_kb,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+T=$(tr -d '\n\r' < "$SEQ" | wc -c)
+for S in $STATE_VALUES; do
+    MODEL="datasets_extreme/models/random_s$S.hmm"
+    for ALG in forward viterbi; do
+        # Scaled (default) and log-space sweeps; the log-space one runs vectorized exp/log per step.
+        for ARITH in scaled log; do
+            echo "Testing $ALG ($ARITH) with S=$S on T=$T..."
+            output=$(./build/${ALG}_checkpoint "$SEQ" 64 1 EXTREME --model "$MODEL" --arith $ARITH)
+            runtime=$(field "$output" Time_us)
+            rate=$(field "$output" Transitions_per_s)
+            kernel=$(field "$output" HMM_Kernel)
+            rss=$(field "$output" Memory_kb)
+            log_result=$(field "$output" Log_Likelihood)
+            [ -z "$log_result" ] && log_result=$(field "$output" Path_Log_Probability)
+            echo "  Time_us=$runtime Transitions_per_s=$rate Kernel=$kernel"
+            echo "$ALG,$PLATFORM,$T,$S,$ARITH,$kernel,$runtime,$rate,$log_result,$rss,Success" >> $CSV_FILE
+        done
+    done
+done
+
+echo "[SRF] HMM state scaling benchmark finished."
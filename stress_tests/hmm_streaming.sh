@@ -0,0 +1,52 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Streaming Viterbi Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/hmm_streaming_log.csv"
+PLATFORM=$(uname)
+SEQ="datasets_extreme/sequences/seq_a_1000000.txt"
+MODEL="datasets_extreme/models/random_s32.hmm"
+# Small lags force commits before the survivors converge; large ones never bind.
+LAG_VALUES=${SRF_STREAM_LAGS:-"1 4 16 64 4096"}
+
+mkdir -p results/csv
+echo "algorithm,platform,length,states,max_lag,runtime_us,converged,forced,lag_mean,lag_max,window_bytes,latency_mean_us,latency_p50_us,latency_p99_us,latency_max_us,path_log_probability,memory_kb,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+if [ ! -f "$MODEL" ]; then
+    python3 scripts/generate_hmm_models.py
+fi
+
+T=$(tr -d '\n\r' < "$SEQ" | wc -c)
+for M in weather "$MODEL"; do
+    for LAG in $LAG_VALUES; do
+        echo "Testing stream decoding ($M) with max lag $LAG on T=$T..."
+        if [ "$M" = "weather" ]; then
+            output=$(cat "$SEQ" | ./build/viterbi_checkpoint - 64 1 EXTREME --max-lag $LAG)
+        else
+            output=$(cat "$SEQ" | ./build/viterbi_checkpoint - 64 1 EXTREME --max-lag $LAG --model "$M")
+        fi
+        runtime=$(field "$output" Time_us)
+        states=$(field "$output" States)
+        converged=$(field "$output" Stream_Committed_Converged)
+        forced=$(field "$output" Stream_Committed_Forced)
+        lag_mean=$(field "$output" Stream_Lag_Mean)
+        lag_max=$(field "$output" Stream_Lag_Max)
+        window=$(field "$output" Stream_Window_Bytes)
+        lat_mean=$(field "$output" Latency_Mean_us)
+        lat_p50=$(field "$output" Latency_p50_us)
+        lat_p99=$(field "$output" Latency_p99_us)
+        lat_max=$(field "$output" Latency_Max_us)
+        logp=$(field "$output" Path_Log_Probability)
+        mem=$(field "$output" Memory_kb)
+        echo "  Time_us=$runtime Forced=$forced Lag_Max=$lag_max Latency_p99_us=$lat_p99"
+        echo "viterbi-stream,$PLATFORM,$T,$states,$LAG,$runtime,$converged,$forced,$lag_mean,$lag_max,$window,$lat_mean,$lat_p50,$lat_p99,$lat_max,$logp,$mem,Success" >> $CSV_FILE
+    done
+done
+
+echo "[SRF] Streaming Viterbi benchmark finished."
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Parallel-in-Time HMM Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/hmm_time_parallel_log.csv"
+PLATFORM=$(uname)
+SEQ="datasets_extreme/sequences/seq_a_1000000.txt"
+K=1000
+# 0 runs the serial sweep; the scan pays off once threads exceed S + 1.
+THREAD_VALUES=${SRF_HMM_THREADS:-"0 2 4 8 16"}
+
+mkdir -p results/csv
+echo "algorithm,platform,length,threads,segments,runtime_us,matrix_steps,uncertain_segments,fallback_steps,result_check,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+T=$(tr -d '\n\r' < "$SEQ" | wc -c)
+for ALG in forward viterbi; do
+    for N in $THREAD_VALUES; do
+        echo "Testing $ALG with $N threads on T=$T..."
+        if [ "$N" = "0" ]; then
+            output=$(./build/${ALG}_checkpoint "$SEQ" $K 1 EXTREME)
+        else
+            output=$(./build/${ALG}_checkpoint "$SEQ" $K 1 EXTREME --threads $N)
+        fi
+        runtime=$(field "$output" Time_us)
+        segments=$(field "$output" Scan_Segments)
+        matrix=$(field "$output" Scan_Matrix_Steps)
+        uncertain=$(field "$output" Scan_Uncertain_Segments)
+        fallback=$(field "$output" Scan_Fallback_Steps)
+        check=$(field "$output" Result_Check)
+        echo "  Time_us=$runtime Segments=${segments:-1} Uncertain=${uncertain:-0}"
+        echo "$ALG,$PLATFORM,$T,$N,${segments:-1},$runtime,${matrix:-0},${uncertain:-0},${fallback:-0},$check,Success" >> $CSV_FILE
+    done
+done
+
+echo "[SRF] Parallel-in-time HMM benchmark finished."
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Checkpointed Posterior Decoding Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/posterior_decoding_log.csv"
+PLATFORM=$(uname)
+SEQ="datasets_extreme/sequences/seq_a_1000000.txt"
+# K = T keeps one segment, i.e. the full O(T) alpha table.
+K_VALUES=${SRF_POSTERIOR_K:-"10 100 1000 10000 1000000"}
+# Binomial (Revolve) schedule store sizes, in alpha vectors.
+SLOT_VALUES=${SRF_POSTERIOR_SLOTS:-"10 100 2000"}
+
+mkdir -p results/csv
+echo "algorithm,platform,length,schedule,param,runtime_us,peak_rss_kb,checkpoint_bytes,segment_bytes,recompute_steps,recompute_factor,recompute_factor_min,log_likelihood,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+run_case() {
+    local schedule=$1 param=$2
+    shift 2
+    output=$(./build/forward_checkpoint "$SEQ" "$@" 1 EXTREME --posterior $EXTRA)
+    runtime=$(field "$output" Time_us)
+    rss=$(field "$output" Memory_kb)
+    cp_bytes=$(field "$output" Posterior_Checkpoint_Bytes)
+    seg_bytes=$(field "$output" Posterior_Segment_Bytes)
+    recompute=$(field "$output" Posterior_Recompute_Steps)
+    factor=$(field "$output" Recompute_Factor)
+    factor_min=$(field "$output" Recompute_Factor_Min)
+    ll=$(field "$output" Log_Likelihood)
+    echo "  Time_us=$runtime Memory_kb=$rss Checkpoint_Bytes=$cp_bytes Recompute_Factor=$factor (min $factor_min)"
+    echo "Forward-Backward,$PLATFORM,$T,$schedule,$param,$runtime,$rss,$cp_bytes,$seg_bytes,$recompute,$factor,$factor_min,$ll,Success" >> $CSV_FILE
+}
+
+T=$(tr -d '\n\r' < "$SEQ" | wc -c)
+for K in $K_VALUES; do
+    echo "Testing posterior decoding (stride K=$K) on T=$T..."
+    EXTRA="" run_case stride "$K" "$K"
+done
+for C in $SLOT_VALUES; do
+    echo "Testing posterior decoding (binomial, $C slots) on T=$T..."
+    EXTRA="--revolve $C" run_case binomial "$C" 1
+done
+
+echo "[SRF] Posterior decoding benchmark finished."
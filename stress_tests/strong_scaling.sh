@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting Wavefront Strong-Scaling Sweep..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/strong_scaling_log.csv"
+PLATFORM=$(uname)
+SIZE=${SRF_SCALING_SIZE:-10000}
+BLOCK=${SRF_SCALING_BLOCK:-256}
+MAX_THREADS=${SRF_SCALING_MAX_THREADS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)}
+
+mkdir -p results/csv
+echo "algorithm,platform,threads,block_width,runtime_us,speedup,efficiency,cells_per_s,result_check,input_size,status" > $CSV_FILE
+
+SEQ_A="datasets_extreme/sequences/seq_a_$SIZE.txt"
+SEQ_B="datasets_extreme/sequences/seq_b_$SIZE.txt"
+
+BASE_TIME=""
+threads=1
+while [ $threads -le $MAX_THREADS ]; do
+    echo "Testing Needleman-Wunsch wavefront with $threads thread(s) at size $SIZE..."
+    output=$(./build/nw_blocked "$SEQ_A" "$SEQ_B" $BLOCK 1 EXTREME --threads $threads)
+
+    runtime=$(echo "$output" | grep -w "Time_us:" | cut -d' ' -f2- | tr -d '\r')
+    cells=$(echo "$output" | grep -w "Cells_per_s:" | cut -d' ' -f2- | tr -d '\r')
+    result=$(echo "$output" | grep -w "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+
+    [ -z "$BASE_TIME" ] && BASE_TIME=$runtime
+    speedup=$(awk -v b=$BASE_TIME -v t=$runtime 'BEGIN { printf "%.3f", (t > 0) ? b / t : 0 }')
+    efficiency=$(awk -v s=$speedup -v p=$threads 'BEGIN { printf "%.3f", s / p }')
+    echo "  Time_us=$runtime Speedup=$speedup Efficiency=$efficiency"
+
+    echo "Needleman-Wunsch,$PLATFORM,$threads,$BLOCK,$runtime,$speedup,$efficiency,$cells,$result,$SIZE,Success" >> $CSV_FILE
+
+    if [ $threads -lt $MAX_THREADS ] && [ $((threads * 2)) -gt $MAX_THREADS ]; then
+        threads=$MAX_THREADS
+    else
+        threads=$((threads * 2))
+    fi
+done
+
+echo "[SRF] Strong-scaling sweep finished."
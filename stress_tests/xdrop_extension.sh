@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+set -e
+
+echo "[SRF] Starting X-Drop Extension Benchmark..."
+
+# Ensure we are in the root directory
+cd "$(dirname "$0")/.."
+
+CSV_FILE="results/csv/xdrop_extension_log.csv"
+PLATFORM=$(uname)
+QUERY="datasets_extreme/pathological/seq_skewed_long.txt"
+X_VALUES=${SRF_XDROP_VALUES:-"10 50 200"}
+# The per-cell full sweep against the 1M reference is ~1e9 cells; opt in with SRF_XDROP_FULL_1M=1.
+FULL_1M=${SRF_XDROP_FULL_1M:-0}
+
+mkdir -p results/csv
+echo "algorithm,platform,reference,mode,x_drop,runtime_us,cells_evaluated,cells_skipped,result_check,end_i,end_j,stop,status" > $CSV_FILE
+
+field() { echo "$1" | grep -w "$2:" | cut -d' ' -f2- | tr -d '\r'; }
+
+for REF in "$QUERY" datasets_extreme/sequences/seq_a_10000.txt datasets_extreme/sequences/seq_a_1000000.txt; do
+    name=$(basename "$REF" .txt)
+    if [ "$name" != "seq_a_1000000" ] || [ "$FULL_1M" = "1" ]; then
+        echo "Testing full per-cell Needleman-Wunsch against $name..."
+        output=$(./build/nw_blocked "$QUERY" "$REF" 20 1 EXTREME --engine cell)
+        runtime=$(field "$output" Time_us)
+        result=$(field "$output" Result_Check)
+        cells=$(( $(tr -d '\n\r' < "$QUERY" | wc -c) * $(tr -d '\n\r' < "$REF" | wc -c) ))
+        echo "  Time_us=$runtime Cells=$cells"
+        echo "Needleman-Wunsch,$PLATFORM,$name,full,NA,$runtime,$cells,0,$result,NA,NA,end,Success" >> $CSV_FILE
+    fi
+
+    for x in $X_VALUES; do
+        echo "Testing X-drop extension (X=$x) against $name..."
+        output=$(./build/nw_blocked "$QUERY" "$REF" 20 1 EXTREME --xdrop $x)
+        runtime=$(field "$output" Time_us)
+        evaluated=$(field "$output" Cells_Evaluated)
+        skipped=$(field "$output" Cells_Skipped)
+        result=$(field "$output" Result_Check)
+        end_i=$(field "$output" Extension_End_i)
+        end_j=$(field "$output" Extension_End_j)
+        stop=$(field "$output" Extension_Stop)
+        echo "  Time_us=$runtime Cells_Evaluated=$evaluated Score=$result Stop=$stop"
+        echo "Needleman-Wunsch,$PLATFORM,$name,xdrop,$x,$runtime,$evaluated,$skipped,$result,$end_i,$end_j,$stop,Success" >> $CSV_FILE
+    done
+done
+
+echo "[SRF] X-drop extension benchmark finished."
@@ -11,12 +11,14 @@ bash benchmarks/build.sh
 
 # Helper to run binaries with optional .exe
 run_bin() {
-    if [ -f "./build/$1.exe" ]; then
-        ./build/$1.exe "$2" "$3" "$4" "$5" "$6"
-    elif [ -f "./build/$1" ]; then
-        ./build/$1 "$2" "$3" "$4" "$5" "$6"
+    local bin=$1
+    shift
+    if [ -f "./build/$bin.exe" ]; then
+        ./build/$bin.exe "$@"
+    elif [ -f "./build/$bin" ]; then
+        ./build/$bin "$@"
     else
-        echo "[ERROR] Binary $1 not found in build/"
+        echo "[ERROR] Binary $bin not found in build/"
         exit 1
     fi
 }
@@ -35,6 +37,250 @@ if [ "$BASE_NW" != "$SRF_NW" ]; then
 fi
 echo "[PASS] Needleman-Wunsch Equivalence"
 
+# 1b. Needleman-Wunsch Wavefront Equivalence (non-square tiles at the matrix edge; tiles wider than the matrix)
+SRF_NW_WF=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 7 1 XS --threads 3 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$SRF_NW_WF" ]; then
+    echo "[FAIL] Needleman-Wunsch Wavefront: Baseline $BASE_NW != SRF $SRF_NW_WF"
+    exit 1
+fi
+# A tile wider than the sequence (row buffers sized to min(B, m)); --banded overrides --threads and runs on one thread
+SRF_NW_WIDE_TILE=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 500 1 XS --threads 2 | grep -E "Threads:|Result_Check:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+SRF_NW_BAND_THREADS=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --threads 2 --banded | grep "Threads:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$SRF_NW_WIDE_TILE" != "2 $BASE_NW " ] || [ "$SRF_NW_BAND_THREADS" != "1" ]; then
+    echo "[FAIL] Needleman-Wunsch Wavefront: B > m gave '$SRF_NW_WIDE_TILE', banded Threads '$SRF_NW_BAND_THREADS'"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Wavefront Equivalence"
+
+# 1c. Needleman-Wunsch SIMD Kernel Equivalence (each ISA tier; unsupported tiers clamp down to what the host has)
+#     A 33000-base self-alignment scores past INT16_MAX, so it must take the 32-bit lanes and still be exact.
+SEQ_ID=$(mktemp)
+head -c 33000 datasets_extreme/sequences/seq_a_50000.txt > "$SEQ_ID"
+for ISA in simd-sse41 simd-avx2 simd; do
+    SRF_NW_SIMD=$(SRF_CPU_KERNEL=$ISA run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    if [ "$BASE_NW" != "$SRF_NW_SIMD" ]; then
+        rm -f "$SEQ_ID"
+        echo "[FAIL] Needleman-Wunsch SIMD ($ISA): Baseline $BASE_NW != SRF $SRF_NW_SIMD"
+        exit 1
+    fi
+    SRF_NW_WIDE=$(SRF_CPU_KERNEL=$ISA run_bin nw_blocked "$SEQ_ID" "$SEQ_ID" 20 1 EXTREME | grep -E "Kernel:|Result_Check:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+    case "$SRF_NW_WIDE" in
+        simd-*-i32*" 33000 ") ;;
+        *)
+            rm -f "$SEQ_ID"
+            echo "[FAIL] Needleman-Wunsch SIMD ($ISA): 33000-base self-alignment gave '$SRF_NW_WIDE' (expected 32-bit lanes, 33000)"
+            exit 1
+            ;;
+    esac
+done
+rm -f "$SEQ_ID"
+echo "[PASS] Needleman-Wunsch SIMD Kernel Equivalence"
+
+# 1d. Needleman-Wunsch Traceback: the recovered path must re-score to the baseline optimum
+SRF_NW_TB=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 8 1 XS --traceback | grep "Alignment_Score:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$SRF_NW_TB" ]; then
+    echo "[FAIL] Needleman-Wunsch Traceback: Baseline $BASE_NW != Path score $SRF_NW_TB"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Traceback Optimality"
+
+# 1e. Needleman-Wunsch Banded Equivalence (band must certify the global optimum)
+SRF_NW_BAND=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 4 1 XS --banded | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$SRF_NW_BAND" ]; then
+    echo "[FAIL] Needleman-Wunsch Banded: Baseline $BASE_NW != SRF $SRF_NW_BAND"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Banded Equivalence"
+
+# 1f. Batch Driver Equivalence (same pair scheduled several times across workers)
+MANIFEST=$(mktemp)
+for k in 1 2 3 4; do echo "$SEQ_H $SEQ_N" >> "$MANIFEST"; done
+BATCH_NW=$(run_bin nw_batch "$MANIFEST" 20 1 XS --threads 2 | grep "Pair_Result:" | cut -d' ' -f5 | tr -d '\r' | sort -u)
+rm -f "$MANIFEST"
+if [ "$BASE_NW" != "$BATCH_NW" ]; then
+    echo "[FAIL] Needleman-Wunsch Batch: Baseline $BASE_NW != Batch $BATCH_NW"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Batch Equivalence"
+
+# 1g. Inter-Task SIMD Batch (each ISA tier, as in 1c; every lane checked against the scalar baseline,
+#     incl. pathological lengths)
+P=datasets_extreme/pathological
+MANIFEST=$(mktemp)
+declare -A INTER_EXPECT
+for a in $P/seq_tiny_a.txt $P/seq_tiny_b.txt $P/seq_skewed_short.txt $P/seq_skewed_long.txt "$SEQ_H" "$SEQ_N"; do
+    for b in $P/seq_tiny_a.txt $P/seq_tiny_b.txt $P/seq_skewed_short.txt $P/seq_skewed_long.txt "$SEQ_H" "$SEQ_N"; do
+        echo "$a $b" >> "$MANIFEST"
+        INTER_EXPECT["$a $b"]=$(run_bin needleman_wunsch "$a" "$b" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    done
+done
+for ISA in simd-scalar simd-sse41 simd-avx2 simd; do
+    INTER_RUN=$(SRF_CPU_KERNEL=$ISA run_bin nw_batch "$MANIFEST" 20 1 XS --intertask --chunk 7)
+    INTER_KERNEL=$(echo "$INTER_RUN" | grep "^Kernel:" | cut -d' ' -f2- | tr -d '\r')
+    INTER_OUT=$(echo "$INTER_RUN" | grep "Pair_Result:" | tr -d '\r')
+    case "$ISA:$INTER_KERNEL" in
+        simd-scalar:intertask-scalar-*|simd-sse41:intertask-*|simd-avx2:intertask-*|simd:intertask-*) ;;
+        *)
+            rm -f "$MANIFEST"
+            echo "[FAIL] Needleman-Wunsch Inter-Task ($ISA): ran kernel '$INTER_KERNEL'"
+            exit 1
+            ;;
+    esac
+    while read -r _ _ A B SCORE _; do
+        if [ "${INTER_EXPECT["$A $B"]}" != "$SCORE" ]; then
+            rm -f "$MANIFEST"
+            echo "[FAIL] Needleman-Wunsch Inter-Task ($ISA): $A vs $B Baseline ${INTER_EXPECT["$A $B"]} != Lane $SCORE"
+            exit 1
+        fi
+    done <<< "$INTER_OUT"
+    if [ "$(echo "$INTER_OUT" | wc -l)" -ne 36 ]; then
+        rm -f "$MANIFEST"
+        echo "[FAIL] Needleman-Wunsch Inter-Task ($ISA): expected 36 pair results"
+        exit 1
+    fi
+done
+rm -f "$MANIFEST"
+echo "[PASS] Needleman-Wunsch Inter-Task SIMD Equivalence"
+
+# 1h. Packed Sequences (human_xl carries an N exception base; odd tile width crosses mask words; UTF-8 bytes as exceptions)
+XL_H=datasets/sequences/processed/human_xl.txt
+XL_N=datasets/sequences/processed/neand_xl.txt
+BASE_XL=$(run_bin needleman_wunsch "$XL_H" "$XL_N" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+PACKED_XL=$(run_bin nw_blocked "$XL_H" "$XL_N" 37 1 XL --threads 2 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_XL" != "$PACKED_XL" ]; then
+    echo "[FAIL] Needleman-Wunsch Packed: Baseline $BASE_XL != Packed $PACKED_XL"
+    exit 1
+fi
+# Exception bytes >= 0x80 (negative as signed char) must still be found in the sorted side list
+NON_ASCII=$(mktemp)
+printf 'AC\xc3\xa9GT\nAC\xc3\xa9GT\n' > "$NON_ASCII"
+BASE_NA=$(run_bin needleman_wunsch "$NON_ASCII" "$NON_ASCII" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+for ARGS in "" "--engine cell" "--threads 2"; do
+    PACKED_NA=$(run_bin nw_blocked "$NON_ASCII" "$NON_ASCII" 4 1 XS $ARGS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    if [ "$BASE_NA" != "$PACKED_NA" ]; then
+        rm -f "$NON_ASCII"
+        echo "[FAIL] Needleman-Wunsch Packed Non-ASCII ($ARGS): Baseline $BASE_NA != Packed $PACKED_NA"
+        exit 1
+    fi
+done
+rm -f "$NON_ASCII"
+# N blocks are stored as run-length ranges: runs crossing mask words, adjacent runs of different
+# bytes, and a footprint well under one byte per base
+N_RUN_A=$(mktemp)
+N_RUN_B=$(mktemp)
+{ head -c 40 "$XL_H"; printf 'N%.0s' $(seq 1500); printf 'nnnNNN'; head -c 300 "$XL_N"; printf 'N%.0s' $(seq 700); echo; } > "$N_RUN_A"
+{ printf 'N%.0s' $(seq 900); head -c 500 "$XL_N"; printf 'N%.0s' $(seq 1100); echo; } > "$N_RUN_B"
+BASE_NR=$(run_bin needleman_wunsch "$N_RUN_A" "$N_RUN_B" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+for ARGS in "" "--engine cell" "--threads 2"; do
+    OUT_NR=$(run_bin nw_blocked "$N_RUN_A" "$N_RUN_B" 37 1 XL $ARGS)
+    PACKED_NR=$(echo "$OUT_NR" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    BYTES_NR=$(echo "$OUT_NR" | grep "Sequence_Bytes:" | cut -d' ' -f2 | tr -d '\r')
+    if [ "$BASE_NR" != "$PACKED_NR" ] || [ "$BYTES_NR" -ge 2500 ]; then
+        rm -f "$N_RUN_A" "$N_RUN_B"
+        echo "[FAIL] Needleman-Wunsch Packed N Runs ($ARGS): Baseline $BASE_NR != Packed $PACKED_NR (Sequence_Bytes $BYTES_NR)"
+        exit 1
+    fi
+done
+rm -f "$N_RUN_A" "$N_RUN_B"
+echo "[PASS] Needleman-Wunsch Packed Sequence Equivalence"
+
+# 1i. Bit-Parallel Engine (auto-selected for unit-cost scoring on the CPU backend) vs per-cell row sweep
+P=datasets_extreme/pathological
+for pair in "$P/seq_tiny_a.txt $P/seq_tiny_b.txt" "$P/seq_skewed_long.txt $P/seq_skewed_short.txt" "$XL_N $XL_H"; do
+    set -- $pair
+    EXPECT=$(run_bin needleman_wunsch "$1" "$2" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    BITPAR=$(run_bin nw_blocked "$1" "$2" 20 1 XS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    if [ "$EXPECT" != "$BITPAR" ]; then
+        echo "[FAIL] Needleman-Wunsch Bit-Parallel: $1 vs $2 Baseline $EXPECT != Bit-Parallel $BITPAR"
+        exit 1
+    fi
+done
+SRF_NW_CELL=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --engine cell | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$SRF_NW_CELL" ]; then
+    echo "[FAIL] Needleman-Wunsch Cell Engine: Baseline $BASE_NW != SRF $SRF_NW_CELL"
+    exit 1
+fi
+# auto keeps a non-CPU backend on its own cell kernel; --engine bitpar forces the host engine anyway
+GPU_AUTO=$(SRF_FORCE_GPU=1 run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS | grep -E "^(Mode|Result_Check):" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+GPU_BITPAR=$(SRF_FORCE_GPU=1 run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --engine bitpar | grep -E "^(Mode|Result_Check):" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$GPU_AUTO" != "serial $BASE_NW " ] || [ "$GPU_BITPAR" != "bitparallel $BASE_NW " ]; then
+    echo "[FAIL] Needleman-Wunsch Engine Selection on GPU: auto '$GPU_AUTO', bitpar '$GPU_BITPAR' (expected serial / bitparallel $BASE_NW)"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Bit-Parallel Equivalence"
+
+# 1j. Cache-Blocked Tiling (tiny cache budget forces many partial tiles)
+SRF_NW_TILED=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --tiled --cache-kb 1 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$SRF_NW_TILED" ]; then
+    echo "[FAIL] Needleman-Wunsch Tiled: Baseline $BASE_NW != Tiled $SRF_NW_TILED"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Cache-Blocked Tiling Equivalence"
+
+# 1k. Delta-Encoded Checkpoint Traceback (8 KB budget: several checkpoints, multi-block backtrack, store + block within it)
+SRF_NW_CP=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --traceback --checkpoint-kb 8 | grep -E "Traceback_Method:|Alignment_Score:|Traceback_Memory_Est_kb:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+read -r CP_METHOD CP_SCORE CP_KB <<< "$SRF_NW_CP"
+if [ "$CP_METHOD" != "checkpoint" ] || [ "$BASE_NW" != "$CP_SCORE" ] || [ "$CP_KB" -gt 8 ]; then
+    echo "[FAIL] Needleman-Wunsch Checkpoint Traceback: Baseline $BASE_NW, got '$SRF_NW_CP' (method, score, KB within 8)"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Checkpoint Traceback Optimality"
+
+# A 1 KB budget cannot hold two raw rows of human_xl: the Hirschberg fallback keeps traceback memory O(m)
+SEQ_XL_H="datasets/sequences/processed/human_xl.txt"
+SEQ_XL_N="datasets/sequences/processed/neand_xl.txt"
+HB_XL=$(run_bin nw_blocked "$SEQ_XL_H" "$SEQ_XL_N" 20 1 XL --traceback | grep -E "Alignment_Score:|Traceback_Memory_Est_kb:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+CP_XL=$(run_bin nw_blocked "$SEQ_XL_H" "$SEQ_XL_N" 20 1 XL --traceback --checkpoint-kb 1 | grep -E "Alignment_Score:|Traceback_Memory_Est_kb:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+read -r HB_SCORE HB_KB <<< "$HB_XL"
+read -r CP_SCORE CP_KB <<< "$CP_XL"
+if [ "$HB_SCORE" != "$CP_SCORE" ] || [ "$CP_KB" -gt $((2 * HB_KB)) ]; then
+    echo "[FAIL] Needleman-Wunsch Checkpoint Tiny Budget: Hirschberg '$HB_XL' vs checkpoint '$CP_XL' (score, KB)"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Checkpoint Tiny Budget Stays Linear"
+
+# 1l. X-Drop Extension (self-extension reaches the corner; an unbounded X never scores below global NW)
+SKEW=datasets_extreme/pathological/seq_skewed_long.txt
+XDROP_SELF=$(run_bin nw_blocked "$SKEW" "$SKEW" 20 1 S --xdrop 20 | grep -E "Result_Check:|Extension_End_i:|Extension_End_j:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$XDROP_SELF" != "1000 1000 1000 " ]; then
+    echo "[FAIL] Needleman-Wunsch X-Drop: self-extension gave '$XDROP_SELF'"
+    exit 1
+fi
+XDROP_OPEN=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --xdrop 100000 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$XDROP_OPEN" -lt "$BASE_NW" ]; then
+    echo "[FAIL] Needleman-Wunsch X-Drop: extension $XDROP_OPEN < global $BASE_NW"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch X-Drop Extension"
+
+# 1m. Streaming Query Side (stdin with 1 KB chunks crosses chunk boundaries; file stream on the per-cell sweep; FASTA record)
+STREAM_NW=$(cat "$XL_H" | run_bin nw_blocked - "$XL_N" 20 1 XL --chunk-kb 1 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_XL" != "$STREAM_NW" ]; then
+    echo "[FAIL] Needleman-Wunsch Streaming: Baseline $BASE_XL != Stream $STREAM_NW"
+    exit 1
+fi
+STREAM_CELL=$(run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --stream --chunk-kb 1 --engine cell | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_NW" != "$STREAM_CELL" ]; then
+    echo "[FAIL] Needleman-Wunsch Streaming (cell): Baseline $BASE_NW != Stream $STREAM_CELL"
+    exit 1
+fi
+# FASTA input: the stream and the whole-file loader share one parser, so both align the first record's lines joined
+# (60-column lines, a second record that must be ignored)
+STREAM_FASTA=$(mktemp)
+{ echo ">human_xl test record"; fold -w 60 "$XL_H"; echo; echo ">second"; echo "ACGT"; } > "$STREAM_FASTA"
+STREAM_FA=$(run_bin nw_blocked "$STREAM_FASTA" "$XL_N" 20 1 XL --stream --chunk-kb 1 | grep -E "Stream_Rows:|Result_Check:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+LOADED_FA=$(run_bin nw_blocked "$STREAM_FASTA" "$XL_N" 20 1 XL | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+rm -f "$STREAM_FASTA"
+if [ "$STREAM_FA" != "$BASE_XL 4000 " ] || [ "$LOADED_FA" != "$BASE_XL" ]; then
+    echo "[FAIL] Needleman-Wunsch Streaming (FASTA): Baseline $BASE_XL, stream (score, rows) '$STREAM_FA', loaded '$LOADED_FA'"
+    exit 1
+fi
+if run_bin nw_blocked "$SEQ_H" "$SEQ_N" 20 1 XS --stream --traceback > /dev/null 2>&1; then
+    echo "[FAIL] Needleman-Wunsch Streaming: --stream --traceback was accepted"
+    exit 1
+fi
+echo "[PASS] Needleman-Wunsch Streaming Query"
+
 # 2. Viterbi Equivalence
 BASE_V=$(run_bin viterbi "$SEQ_H" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
 SRF_V=$(run_bin viterbi_checkpoint "$SEQ_H" 10 1 XS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
@@ -44,6 +290,44 @@ if [ "$BASE_V" != "$SRF_V" ]; then
 fi
 echo "[PASS] Viterbi Equivalence"
 
+# 2b. Viterbi Path Recovery (checkpoint-segment backtrace vs the full-table reference path)
+TB_V=$(run_bin viterbi_checkpoint "$SEQ_H" 10 1 XS --traceback | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$BASE_V" != "$TB_V" ]; then
+    echo "[FAIL] Viterbi Traceback: Baseline $BASE_V != Path $TB_V"
+    exit 1
+fi
+REF_PATH=$(mktemp)
+SRF_PATH=$(mktemp)
+for seq in datasets_extreme/sequences/seq_a_10000.txt datasets_extreme/sequences/seq_b_100000.txt; do
+    run_bin viterbi "$seq" "$REF_PATH" > /dev/null
+    run_bin viterbi_checkpoint "$seq" 64 1 EXTREME --traceback --path-out "$SRF_PATH" > /dev/null
+    if ! cmp -s "$REF_PATH" "$SRF_PATH"; then
+        rm -f "$REF_PATH" "$SRF_PATH"
+        echo "[FAIL] Viterbi Traceback: path differs from the full-table reference on $seq"
+        exit 1
+    fi
+done
+rm -f "$REF_PATH" "$SRF_PATH"
+echo "[PASS] Viterbi Path Recovery"
+
+# 2c. Binomial Checkpoint Schedule (5 slots: path unchanged, forward steps at the binomial minimum)
+REF_PATH=$(mktemp)
+SRF_PATH=$(mktemp)
+run_bin viterbi datasets_extreme/sequences/seq_a_10000.txt "$REF_PATH" > /dev/null
+REVOLVE_V=$(run_bin viterbi_checkpoint datasets_extreme/sequences/seq_a_10000.txt 64 1 EXTREME --traceback --revolve 5 --path-out "$SRF_PATH")
+if ! cmp -s "$REF_PATH" "$SRF_PATH"; then
+    rm -f "$REF_PATH" "$SRF_PATH"
+    echo "[FAIL] Viterbi Binomial Schedule: path differs from the full-table reference"
+    exit 1
+fi
+rm -f "$REF_PATH" "$SRF_PATH"
+REVOLVE_STEPS=$(echo "$REVOLVE_V" | grep -E "^Forward_Steps:|^Forward_Steps_Min:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$(echo $REVOLVE_STEPS | cut -d' ' -f1)" != "$(echo $REVOLVE_STEPS | cut -d' ' -f2)" ]; then
+    echo "[FAIL] Viterbi Binomial Schedule: forward steps '$REVOLVE_STEPS' miss the binomial minimum"
+    exit 1
+fi
+echo "[PASS] Viterbi Binomial Checkpoint Schedule"
+
 # 3. Forward Equivalence
 BASE_F=$(run_bin forward "$SEQ_H" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
 SRF_F=$(run_bin forward_checkpoint "$SEQ_H" 10 1 XS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
@@ -51,8 +335,168 @@ if [ "$BASE_F" != "$SRF_F" ]; then
     echo "[FAIL] Forward: Baseline $BASE_F != SRF $SRF_F"
     exit 1
 fi
+# An empty observation file: every arithmetic of the stride sweep answers like the traceback engines
+EMPTY_OBS=$(mktemp)
+for BIN in forward_checkpoint viterbi_checkpoint; do
+    EMPTY_REF=$(run_bin $BIN "$EMPTY_OBS" 10 1 XS --traceback | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    for ARITH in linear scaled log; do
+        EMPTY_RUN=$(run_bin $BIN "$EMPTY_OBS" 10 1 XS --arith $ARITH | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+        if [ -z "$EMPTY_RUN" ] || [ "$EMPTY_RUN" != "$EMPTY_REF" ]; then
+            rm -f "$EMPTY_OBS"
+            echo "[FAIL] Forward: $BIN --arith $ARITH on empty input gave '$EMPTY_RUN' (traceback engine: '$EMPTY_REF')"
+            exit 1
+        fi
+    done
+done
+rm -f "$EMPTY_OBS"
 echo "[PASS] Forward Equivalence"
 
+# 3b. Checkpointed Posterior Decoding (likelihood matches the baseline; K = 7 matches a single full-table segment)
+POST_F=$(run_bin forward_checkpoint "$SEQ_H" 7 1 XS --posterior | grep -E "Result_Check:|Posterior_Occupancy:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+POST_FULL=$(run_bin forward_checkpoint "$SEQ_H" 100000 1 XS --posterior | grep -E "Result_Check:|Posterior_Occupancy:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$POST_F" != "$BASE_F $(echo "$POST_FULL" | cut -d' ' -f2-)" ]; then
+    echo "[FAIL] Forward Posterior: '$POST_F' vs baseline $BASE_F / full table '$POST_FULL'"
+    exit 1
+fi
+echo "[PASS] Forward Posterior Decoding"
+
+# 3c. Binomial Schedule Posteriors (3 slots give the same likelihood and occupancy)
+POST_REVOLVE=$(run_bin forward_checkpoint "$SEQ_H" 7 1 XS --posterior --revolve 3 | grep -E "Result_Check:|Posterior_Occupancy:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$POST_REVOLVE" != "$POST_F" ]; then
+    echo "[FAIL] Forward Posterior Binomial Schedule: '$POST_REVOLVE' != '$POST_F'"
+    exit 1
+fi
+echo "[PASS] Forward Posterior Binomial Schedule"
+
+# 3d. Model Files (weather.hmm reproduces the built-in model; splitting each state into 20 copies keeps the likelihood)
+MODEL_F=$(run_bin forward_checkpoint "$SEQ_H" 10 1 XS --model datasets/models/weather.hmm | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+MODEL_V=$(run_bin viterbi_checkpoint "$SEQ_H" 10 1 XS --model datasets/models/weather.hmm | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+SPLIT_F=$(run_bin forward_checkpoint "$SEQ_H" 10 1 XS --model datasets/models/weather_split_40.hmm | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$MODEL_F $MODEL_V $SPLIT_F" != "$BASE_F $BASE_V $BASE_F" ]; then
+    echo "[FAIL] HMM Model Files: '$MODEL_F $MODEL_V $SPLIT_F' vs baseline '$BASE_F $BASE_V $BASE_F'"
+    exit 1
+fi
+echo "[PASS] HMM Model Files"
+
+# 3e. Parallel-in-Time HMM (4 threads: likelihoods match the baseline, posteriors and the decoded path match serial)
+PAR_F=$(run_bin forward_checkpoint "$SEQ_H" 10 1 XS --threads 4 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+PAR_V=$(run_bin viterbi_checkpoint "$SEQ_H" 10 1 XS --threads 4 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+PAR_POST=$(run_bin forward_checkpoint "$SEQ_H" 7 1 XS --posterior --threads 4 | grep -E "Result_Check:|Posterior_Occupancy:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$PAR_F $PAR_V $PAR_POST" != "$BASE_F $BASE_V $POST_F" ]; then
+    echo "[FAIL] Parallel-in-Time HMM: '$PAR_F $PAR_V $PAR_POST' vs '$BASE_F $BASE_V $POST_F'"
+    exit 1
+fi
+REF_PATH=$(mktemp)
+SRF_PATH=$(mktemp)
+run_bin viterbi datasets_extreme/sequences/seq_b_100000.txt "$REF_PATH" > /dev/null
+run_bin viterbi_checkpoint datasets_extreme/sequences/seq_b_100000.txt 64 1 EXTREME --traceback --threads 4 --path-out "$SRF_PATH" > /dev/null
+if ! cmp -s "$REF_PATH" "$SRF_PATH"; then
+    rm -f "$REF_PATH" "$SRF_PATH"
+    echo "[FAIL] Parallel-in-Time HMM: path differs from the full-table reference"
+    exit 1
+fi
+rm -f "$REF_PATH" "$SRF_PATH"
+echo "[PASS] Parallel-in-Time HMM"
+
+# 3f. Batched HMM Scoring (every record, SIMD lanes and per-cell default, checked against its own posterior run)
+P=datasets_extreme/pathological
+RECORDS=$(mktemp)
+FILES="$P/seq_tiny_a.txt $SEQ_H $P/seq_skewed_long.txt $SEQ_N datasets/sequences/processed/human_s.txt $P/seq_skewed_short.txt $P/seq_tiny_b.txt"
+for f in $FILES; do
+    echo ">$f" >> "$RECORDS"
+    cat "$f" >> "$RECORDS"
+    echo >> "$RECORDS"
+done
+for KERNEL in simd cell; do
+    BATCH_OUT=$(SRF_CPU_KERNEL=$KERNEL run_bin hmm_batch "$RECORDS" 4 XS --threads 2 | grep "Sequence_Result:" | tr -d '\r')
+    if [ "$(echo "$BATCH_OUT" | wc -l)" -ne 7 ]; then
+        rm -f "$RECORDS"
+        echo "[FAIL] Batched HMM ($KERNEL): expected 7 results"
+        exit 1
+    fi
+    while read -r _ _ F _ LL; do
+        EXPECT=$(run_bin forward_checkpoint "$F" 7 1 XS --posterior | grep "Log_Likelihood:" | cut -d' ' -f2- | tr -d '\r')
+        if [ "$EXPECT" != "$LL" ]; then
+            rm -f "$RECORDS"
+            echo "[FAIL] Batched HMM ($KERNEL): $F posterior $EXPECT != lane $LL"
+            exit 1
+        fi
+    done <<< "$BATCH_OUT"
+done
+rm -f "$RECORDS"
+echo "[PASS] Batched HMM Scoring"
+
+# 3g. Scaled and Log-Space Arithmetic (baseline results at T = 200; at T = 100000 where linear underflows,
+#     scaled and log-space sweeps agree with the posterior and traceback engines)
+for ARITH in linear scaled log; do
+    A_F=$(run_bin forward_checkpoint "$SEQ_H" 10 1 XS --arith $ARITH | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    A_V=$(run_bin viterbi_checkpoint "$SEQ_H" 10 1 XS --arith $ARITH | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    if [ "$A_F $A_V" != "$BASE_F $BASE_V" ]; then
+        echo "[FAIL] HMM Arithmetic ($ARITH): '$A_F $A_V' vs baseline '$BASE_F $BASE_V'"
+        exit 1
+    fi
+done
+LONG=datasets_extreme/sequences/seq_b_100000.txt
+REF_F=$(run_bin forward_checkpoint "$LONG" 64 1 EXTREME --posterior | grep "Log_Likelihood:" | cut -d' ' -f2- | tr -d '\r')
+REF_V=$(run_bin viterbi_checkpoint "$LONG" 64 1 EXTREME --traceback | grep "Path_Log_Probability:" | cut -d' ' -f2- | tr -d '\r')
+for ARITH in scaled log; do
+    A_F=$(run_bin forward_checkpoint "$LONG" 64 1 EXTREME --arith $ARITH | grep "Log_Likelihood:" | cut -d' ' -f2- | tr -d '\r')
+    A_V=$(run_bin viterbi_checkpoint "$LONG" 64 1 EXTREME --arith $ARITH | grep "Path_Log_Probability:" | cut -d' ' -f2- | tr -d '\r')
+    if [ "$A_F $A_V" != "$REF_F $REF_V" ]; then
+        echo "[FAIL] HMM Arithmetic ($ARITH, T = 100000): '$A_F $A_V' vs '$REF_F $REF_V'"
+        exit 1
+    fi
+done
+echo "[PASS] Scaled and Log-Space HMM Arithmetic"
+
+# 3h. Streaming Viterbi (from stdin: an unbounded lag reproduces the full-table path; a lag of 4 is honoured)
+REF_PATH=$(mktemp)
+SRF_PATH=$(mktemp)
+run_bin viterbi "$LONG" "$REF_PATH" > /dev/null
+STREAM_V=$(cat "$LONG" | run_bin viterbi_checkpoint - 64 1 EXTREME --max-lag 100000 --path-out "$SRF_PATH" | grep -E "Path_Log_Probability:|Stream_Committed_Forced:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+if [ "$STREAM_V" != "$REF_V 0 " ] || ! cmp -s "$REF_PATH" "$SRF_PATH"; then
+    rm -f "$REF_PATH" "$SRF_PATH"
+    echo "[FAIL] Streaming Viterbi: '$STREAM_V' vs '$REF_V 0', or path differs from the full-table reference"
+    exit 1
+fi
+STREAM_LAG=$(run_bin viterbi_checkpoint "$LONG" 64 1 EXTREME --stream --max-lag 4 --path-out "$SRF_PATH" | grep "Stream_Lag_Max:" | cut -d' ' -f2- | tr -d '\r')
+STREAM_LINES=$(wc -l < "$SRF_PATH")
+rm -f "$REF_PATH" "$SRF_PATH"
+if [ "$STREAM_LAG" -gt 4 ] || [ "$STREAM_LINES" -ne 100000 ]; then
+    echo "[FAIL] Streaming Viterbi: max lag $STREAM_LAG > 4 or $STREAM_LINES path lines"
+    exit 1
+fi
+echo "[PASS] Streaming Viterbi"
+
+# 3i. Baum-Welch Training (the first E-step scores like the posterior engine, the likelihood never drops,
+#     the saved model reproduces the final score, and threads do not change the trained model)
+MODEL_OUT=$(mktemp)
+TRAIN_LL=$(run_bin hmm_train "$SEQ_H" 5 XS --model-out "$MODEL_OUT" | grep "Iteration:" | cut -d' ' -f3 | tr -d '\r')
+TRAINED_LL=$(run_bin forward_checkpoint "$SEQ_H" 7 1 XS --posterior --model "$MODEL_OUT" | grep "Log_Likelihood:" | cut -d' ' -f2- | tr -d '\r')
+POST_LL=$(run_bin forward_checkpoint "$SEQ_H" 7 1 XS --posterior | grep "Log_Likelihood:" | cut -d' ' -f2- | tr -d '\r')
+if [ "$(echo "$TRAIN_LL" | head -1) $(echo "$TRAIN_LL" | tail -1)" != "$POST_LL $TRAINED_LL" ] || \
+   ! echo "$TRAIN_LL" | awk 'NR > 1 && $1 < prev { exit 1 } { prev = $1 }'; then
+    rm -f "$MODEL_OUT"
+    echo "[FAIL] Baum-Welch: log-likelihoods '$(echo $TRAIN_LL)' vs posterior $POST_LL / trained model $TRAINED_LL"
+    exit 1
+fi
+RECORDS=$(mktemp)
+for f in $SEQ_H "$LONG" $SEQ_N; do
+    echo ">$f" >> "$RECORDS"
+    cat "$f" >> "$RECORDS"
+    echo >> "$RECORDS"
+done
+MODEL_PAR=$(mktemp)
+run_bin hmm_train "$RECORDS" 2 XS --split 10000 --threads 1 --model-out "$MODEL_OUT" > /dev/null
+run_bin hmm_train "$RECORDS" 2 XS --split 10000 --threads 4 --model-out "$MODEL_PAR" > /dev/null
+if ! cmp -s "$MODEL_OUT" "$MODEL_PAR"; then
+    rm -f "$MODEL_OUT" "$MODEL_PAR" "$RECORDS"
+    echo "[FAIL] Baum-Welch: trained model differs between 1 and 4 threads"
+    exit 1
+fi
+rm -f "$MODEL_OUT" "$MODEL_PAR" "$RECORDS"
+echo "[PASS] Baum-Welch Training"
+
 # 4. Graph-DP Equivalence
 BASE_G=$(run_bin graph_dp "$GRAPH_O" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
 SRF_G=$(run_bin graph_recompute "$GRAPH_O" 2 1 XS | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
@@ -62,4 +506,110 @@ if [ "$BASE_G" != "$SRF_G" ]; then
 fi
 echo "[PASS] Graph-DP Equivalence"
 
+# 4b. CSR Graph Cache (text load, cache write and mapped cache all match the baseline; rewrites invalidate it)
+GRAPH_X=datasets_extreme/graphs/graph_250000.txt
+CSR_CACHE=$(mktemp)
+BASE_X=$(run_bin graph_dp "$GRAPH_X" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+CSR_RUNS=""
+for ARGS in "" "--cache $CSR_CACHE" "--cache $CSR_CACHE"; do
+    CSR_RUNS="$CSR_RUNS$(run_bin graph_recompute "$GRAPH_X" 2 1 EXTREME $ARGS | grep -E "Result_Check:|Graph_Source:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')"
+done
+rm -f "$CSR_CACHE"
+if [ "$CSR_RUNS" != "$BASE_X text $BASE_X text+cache-write $BASE_X cache " ]; then
+    echo "[FAIL] CSR Graph Cache: '$CSR_RUNS' vs baseline $BASE_X"
+    exit 1
+fi
+# A same-size rewrite within the same second must still invalidate the cache (nanosecond mtime)
+TINY=$(mktemp)
+cp datasets_extreme/pathological/graph_tiny.txt "$TINY"
+run_bin graph_recompute "$TINY" 2 1 EXTREME --cache "$CSR_CACHE" > /dev/null
+printf '0 9 1\n' | cat - <(tail -n +2 datasets_extreme/pathological/graph_tiny.txt) > "$TINY"
+TINY_RUN=$(run_bin graph_recompute "$TINY" 2 1 EXTREME --cache "$CSR_CACHE" | grep -E "Result_Check:|Graph_Source:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+rm -f "$TINY" "$CSR_CACHE"
+if [ "$TINY_RUN" != "1 text+cache-write " ]; then
+    echo "[FAIL] CSR Graph Cache: rewritten graph_tiny gave '$TINY_RUN' (expected a stale cache and 1)"
+    exit 1
+fi
+echo "[PASS] CSR Graph Cache"
+
+# 4c. Parallel Edge-List Parser (CSR arrays byte-identical to the sequential loader's; negative ids rejected by both)
+IRREGULAR=$(mktemp)
+printf '0 1 1\n1 2\n1 0 3 1\n1 2 3 1 1\n2 3 1 x 4 1\n' > "$IRREGULAR"
+for GRAPH in "$GRAPH_X" datasets_extreme/pathological/graph_dense.txt datasets_extreme/pathological/graph_tiny.txt "$IRREGULAR"; do
+    STREAM_CSR=$(mktemp)
+    PARALLEL_CSR=$(mktemp)
+    run_bin graph_recompute "$GRAPH" 2 1 EXTREME --cache "$STREAM_CSR" --parser stream > /dev/null
+    PARALLEL_CHECK=$(run_bin graph_recompute "$GRAPH" 2 1 EXTREME --cache "$PARALLEL_CSR" --parser parallel --parse-threads 4 | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    BASE_P=$(run_bin graph_dp "$GRAPH" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    if ! cmp -s "$STREAM_CSR" "$PARALLEL_CSR" || [ "$PARALLEL_CHECK" != "$BASE_P" ]; then
+        echo "[FAIL] Parallel Edge-List Parser: $GRAPH ($PARALLEL_CHECK vs baseline $BASE_P)"
+        exit 1
+    fi
+    rm -f "$STREAM_CSR" "$PARALLEL_CSR"
+done
+rm -f "$IRREGULAR"
+# A negative node id is an error for both parsers (exit status 1, same message), never a truncated graph
+NEGATIVE=$(mktemp)
+printf '0 1 1\n1 2 1\n-1 2 1\n2 5 1\n' > "$NEGATIVE"
+for PARSER in stream parallel; do
+    if NEG_ERR=$(run_bin graph_recompute "$NEGATIVE" 2 1 EXTREME --parser $PARSER 2>&1 >/dev/null); then
+        rm -f "$NEGATIVE"
+        echo "[FAIL] Parallel Edge-List Parser: --parser $PARSER accepted a negative node id"
+        exit 1
+    fi
+    case "$NEG_ERR" in
+        *"negative node id in edge 3"*) ;;
+        *)
+            rm -f "$NEGATIVE"
+            echo "[FAIL] Parallel Edge-List Parser: --parser $PARSER gave '$NEG_ERR' for a negative node id"
+            exit 1
+            ;;
+    esac
+done
+rm -f "$NEGATIVE"
+echo "[PASS] Parallel Edge-List Parser"
+
+# 4d. Level-Parallel Graph-DP (matches the baseline sweep, including back edges)
+BACK_EDGES=$(mktemp)
+printf '0 2 1\n2 1 1\n1 3 1\n0 3 1\n3 0 1\n2 2 1\n3 4 1\n' > "$BACK_EDGES"
+for GRAPH in "$GRAPH_X" datasets_extreme/pathological/graph_layered.txt datasets_extreme/pathological/graph_dense.txt "$BACK_EDGES"; do
+    BASE_L=$(run_bin graph_dp "$GRAPH" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    for N in 1 4; do
+        LEVEL_CHECK=$(run_bin graph_recompute "$GRAPH" 2 1 EXTREME --threads $N | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+        if [ "$LEVEL_CHECK" != "$BASE_L" ]; then
+            echo "[FAIL] Level-Parallel Graph-DP: $GRAPH with $N threads ($LEVEL_CHECK vs baseline $BASE_L)"
+            exit 1
+        fi
+    done
+done
+echo "[PASS] Level-Parallel Graph-DP"
+
+# 4e. Bounded-Memory Graph-DP (evicted spans recomputed from checkpoints match the baseline)
+EVICTIONS=0
+for GRAPH in "$GRAPH_X" datasets_extreme/pathological/graph_layered.txt datasets_extreme/pathological/graph_dense.txt "$BACK_EDGES"; do
+    BASE_B=$(run_bin graph_dp "$GRAPH" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+    for ARGS in "2 1 EXTREME --budget-kb 0" "4 64 EXTREME --budget-kb 1" "4 1024 EXTREME --budget-kb 16"; do
+        BOUNDED_OUT=$(run_bin graph_recompute "$GRAPH" $ARGS)
+        BOUNDED_CHECK=$(echo "$BOUNDED_OUT" | grep "Result_Check:" | cut -d' ' -f2- | tr -d '\r')
+        EVICTIONS=$((EVICTIONS + $(echo "$BOUNDED_OUT" | grep "Evicted_Blocks:" | cut -d' ' -f2- | tr -d '\r')))
+        if [ "$BOUNDED_CHECK" != "$BASE_B" ]; then
+            echo "[FAIL] Bounded-Memory Graph-DP: $GRAPH ($ARGS: $BOUNDED_CHECK vs baseline $BASE_B)"
+            exit 1
+        fi
+    done
+done
+rm -f "$BACK_EDGES"
+if [ "$EVICTIONS" -eq 0 ]; then
+    echo "[FAIL] Bounded-Memory Graph-DP: no budget forced an eviction"
+    exit 1
+fi
+# graph_layered with 1024-node spans needs about 36 KB (live checkpoints, the span and its copy): 48 KB must hold
+BOUNDED_MET=$(run_bin graph_recompute datasets_extreme/pathological/graph_layered.txt 4 256 EXTREME --budget-kb 48 | grep -E "Budget_Met:|Evicted_Blocks:" | cut -d' ' -f2- | tr -d '\r' | tr '\n' ' ')
+read -r MET EVICTED <<< "$BOUNDED_MET"
+if [ "$MET" != "true" ] || [ "$EVICTED" -eq 0 ]; then
+    echo "[FAIL] Bounded-Memory Graph-DP: 48 KB budget above the floor gave Budget_Met/Evicted_Blocks '$BOUNDED_MET'"
+    exit 1
+fi
+echo "[PASS] Bounded-Memory Graph-DP"
+
 echo "[SRF] All tests passed."